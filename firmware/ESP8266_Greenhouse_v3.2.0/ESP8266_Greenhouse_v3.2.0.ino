@@ -10,6 +10,29 @@
  * - OTA FIRMWARE UPDATE: Update firmware over-the-air from webapp
  * - WiFi Fallback: If new WiFi fails, automatically restore previous credentials
  * - Command acknowledgement: Device reports command execution status
+ * - Command queue: up to 4 commands per heartbeat, acks sent in one batch
+ * - Background commands: wifi_update / OTA run in steps, sampling continues
+ * - Local control: hysteresis / PID actuators from local readings, works offline
+ * - Actuators: relay_no / relay_nc / pwm commands, PWM soft-start ramps
+ * - Actuator safety: max on-time enforced locally, states sent with heartbeat
+ * - Automation rules: cloud conditions compiled to bytecode, run on every sample
+ * - SNTP time: every reading carries its sample time (ts)
+ * - Schedules: weekday timers for actuators, missed-run policy after reboot
+ * - Push commands: Supabase Realtime announces new commands (id only), the
+ *   device fetches them at once with an early heartbeat
+ * - OTA rollback: new image confirmed after 3 min of local health (no backend
+ *   needed), reverted after 3 boots without confirmation
+ * - LAN firmware sharing: peers download a matching image over mDNS/HTTP
+ * - Async local web server: requests never wait on loop() or a slow client
+ * - Local JSON API: /api/status, /api/config, /api/readings (cached snapshots)
+ * - Prometheus metrics: /metrics (sensors, heap, RSSI, loop and RPC timing)
+ * - Live stream: /events (Server-Sent Events, new samples + actuator changes)
+ * - Local history: hourly LittleFS segments, /api/history with downsampling
+ * - Compressed series: delta-of-delta bit packing for history blocks and
+ *   upload retries (samples missed by failed uploads are sent as a batch)
+ * - Fixed-point samples: centi-°C / deci-%RH integers, no float formatting
+ * - Sensor calibration: offset/gain or 8-point tables from the cloud config,
+ *   applied with integer interpolation before readings leave the device
  *
  * FEATURES v3.1.x:
  * - Cloud-based sensor configuration (webapp as single source of truth)
@@ -30,7 +53,8 @@
  *    - If fails, automatically restores backup and reconnects
  *
  * 3. FIRMWARE UPDATE (OTA):
- *    - Device downloads new firmware from Supabase Storage
+ *    - Device downloads new firmware from a LAN peer with the same SHA-256,
+ *      otherwise from Supabase Storage
  *    - Installs and restarts automatically
  *    - LED blinks during update
  *
@@ -55,12 +79,24 @@
 
 #include <ESP8266WiFi.h>
 #include <WiFiManager.h>
+#include <ESP8266mDNS.h>
 #include "config.h"
 #include "portal.h"
 #include "heartbeat.h"
 #include "webserver.h"
 #include "sensors.h"
 #include "commands.h"
+#include "realtime.h"
+#include "transport.h"
+#include "ota.h"
+#include "actuators.h"
+#include "control.h"
+#include "rules.h"
+#include "timesync.h"
+#include "schedules.h"
+#include "metrics.h"
+#include "events.h"
+#include "history.h"
 
 WiFiManager wifiManager;
 WiFiManagerParameter* param_composite_id;
@@ -89,6 +125,12 @@ void setup() {
   Serial.println("Remote Device Management (Reset, WiFi Update, OTA)");
   Serial.println("================================================================================\n");
 
+  // Load state kept across soft restarts (pending acks, OTA confirmation)
+  loadRtcState();
+
+  // Roll back a freshly installed image that keeps failing to boot
+  checkOtaBoot();
+
   pinMode(RESET_BUTTON_PIN, INPUT_PULLUP);
   pinMode(LED_PIN, OUTPUT);
   digitalWrite(LED_PIN, HIGH); // LED off initially (active LOW on ESP8266)
@@ -102,6 +144,19 @@ void setup() {
 
   // Load config
   loadConfig();
+  loadControlConfig();
+  loadRuleProgram();
+  loadSchedules();
+  loadCalibration();
+
+  // Sensors and local control run even if WiFi never comes up
+  initializeSensors();
+  initializeActuators();
+  initializeControl();
+  initializeRules();
+  initializeSchedules();
+  initializeTime();  // SNTP starts once WiFi is connected
+  initializeHistory();
 
   // Check if we have valid config
   if (validateConfig()) {
@@ -135,14 +190,19 @@ void setup() {
       // Setup web server
       setupWebServer();
 
-      // Initialize sensors
-      initializeSensors();
+      // Connect backend transport (HTTPS or MQTT)
+      setupTransport();
+
+      // Deliver acks of commands that restarted the device
+      flushCommandAcks();
 
       // Send first heartbeat and check for commands
       Serial.println("Sending first heartbeat...");
       HeartbeatResponse hbResponse = sendHeartbeat();
 
       if (hbResponse.success) {
+        otaBackendReached();
+
         // Check for config updates
         if (hbResponse.config_version > deviceConfig.config_version) {
           Serial.println("Config update detected on first heartbeat, fetching...");
@@ -151,16 +211,22 @@ void setup() {
             saveConfig();
             Serial.println("Config synced from cloud");
             initializeSensors();
+            initializeActuators();
+            initializeControl();
+            initializeRules();
+            initializeSchedules();
           }
         }
 
-        // Check for pending commands
-        if (hbResponse.command.valid) {
-          Serial.println("Pending command found on first heartbeat!");
-          executeCommand(hbResponse.command);
+        // Pending commands are executed from loop() via the command queue
+        if (hbResponse.commands_queued > 0) {
+          Serial.println("Pending commands found on first heartbeat!");
         }
       }
 
+      // Open push channel so new commands arrive without waiting for heartbeat
+      setupRealtime();
+
       lastHeartbeat = millis();
       return;
     }
@@ -194,29 +260,58 @@ void setup() {
 }
 
 void loop() {
+  unsigned long loopStart = micros();
+
   // Process WiFiManager (needed for non-blocking portal mode)
   wifiManager.process();
 
-  // Handle web server requests (only if WiFi connected)
+  // Web requests are served by the async server, only live events from here
   if (WiFi.status() == WL_CONNECTED) {
-    server.handleClient();
+    handleEvents();
+    MDNS.update();
+    handleTransport();
+    handleRealtime();
   }
 
+  // millis() rollover tracking for sample timestamps
+  updateTime();
+
   // ALWAYS check reset button (works in both normal and portal mode)
   checkResetButton();
 
+  // Advance the background command job (wifi_update runs while disconnected)
+  processCommandQueue();
+
+  // Hash of the running image for LAN peers (/firmware/info), in slices
+  updateImageSha256();
+
+  // Actuator safety limits first, then rules and timers
+  runActuatorWatchdogs();
+
+  // Automation rules: bounded work per loop, pulses end on time
+  runRules();
+
+  // Timers (irrigation): need the SNTP clock, not WiFi
+  runSchedules();
+
   unsigned long now = millis();
 
-  // Only do heartbeat and sensor reads if WiFi is connected
+  // Only do heartbeat if WiFi is connected
   if (WiFi.status() == WL_CONNECTED) {
     // Send heartbeat and check for commands/config updates
-    if (now - lastHeartbeat >= HEARTBEAT_INTERVAL) {
+    // (or early when the Realtime channel announces a new command)
+    if (now - lastHeartbeat >= HEARTBEAT_INTERVAL || realtimePollDue(now - lastHeartbeat)) {
+      // Send leftover acks first so acked commands are not re-delivered
+      flushCommandAcks();
+
       HeartbeatResponse hbResponse = sendHeartbeat();
 
       Serial.printf("Local config_version: %d, Cloud config_version: %d\n",
                     deviceConfig.config_version, hbResponse.config_version);
 
       if (hbResponse.success) {
+        otaBackendReached();
+
         // Check for config updates
         if (hbResponse.config_version > deviceConfig.config_version) {
           Serial.println("Config update detected! Fetching new config...");
@@ -225,27 +320,37 @@ void loop() {
             saveConfig();
             Serial.println("Config synced from cloud");
             initializeSensors();
+            initializeActuators();
+            initializeControl();
+            initializeRules();
+            initializeSchedules();
           }
         }
-
-        // Check for pending commands
-        if (hbResponse.command.valid) {
-          Serial.println("Pending command received!");
-          executeCommand(hbResponse.command);
-          // Note: some commands (reset, wifi_update, ota) will restart device
-        }
       }
 
       lastHeartbeat = now;
     }
 
-    // Read and send sensor data
-    if (now - lastSensorRead >= SENSOR_READ_INTERVAL) {
-      readAndSendSensorData();
-      lastSensorRead = now;
+  }
+
+  // Sample sensors and run local control (independent of WiFi / cloud)
+  if (now - lastSensorRead >= SENSOR_READ_INTERVAL) {
+    readSensors();
+    storeHistory();
+    runControlLoops();
+    triggerRules();
+
+    if (WiFi.status() == WL_CONNECTED && !sendSensorReadings()) {
+      Serial.println("Failed to send sensor readings");
     }
+    lastSensorRead = now;
   }
 
+  recordLoopTime(micros() - loopStart);  // /metrics, without the delay below
+
+  // A new OTA image is confirmed on local health (uptime, sampling, this pass)
+  checkOtaHealth(lastSensorRead != 0);
+
   delay(10); // Small delay to prevent watchdog issues
 }
 
@@ -270,7 +375,7 @@ void checkResetButton() {
     // Print duration every second
     static unsigned long lastPrint = 0;
     if (pressDuration - lastPrint >= 1000) {
-      Serial.printf("Holding: %.1f seconds\n", pressDuration / 1000.0);
+      Serial.printf("Holding: %lu.%lu seconds\n", pressDuration / 1000, (pressDuration / 100) % 10);
       lastPrint = pressDuration;
     }
 
@@ -297,7 +402,7 @@ void checkResetButton() {
     // Button released
     if (buttonPressed) {
       unsigned long pressDuration = millis() - buttonPressStart;
-      Serial.printf("\nButton RELEASED after %.1f seconds\n", pressDuration / 1000.0);
+      Serial.printf("\nButton RELEASED after %lu.%lu seconds\n", pressDuration / 1000, (pressDuration / 100) % 10);
 
       // FULL RESET (10+ seconds)
       if (pressDuration >= FULL_RESET_DURATION) {
@@ -348,7 +453,8 @@ void checkResetButton() {
       }
       // SHORT PRESS (<3 seconds) - ignore
       else {
-        Serial.printf("Short press (%.1f seconds) - no action taken\n", pressDuration / 1000.0);
+        Serial.printf("Short press (%lu.%lu seconds) - no action taken\n",
+                      pressDuration / 1000, (pressDuration / 100) % 10);
       }
 
       buttonPressed = false;
@@ -0,0 +1,198 @@
+#include "actuators.h"
+#include <Ticker.h>
+
+#define PWM_MAX 1023           // analogWrite range (set explicitly, core 3.x defaults to 255)
+#define RAMP_STEP_MS 20        // Ramp timer period
+
+// Runtime state per actuator (not persisted)
+struct ActuatorState {
+  uint16_t duty;               // Current PWM duty (0 - PWM_MAX)
+  uint16_t targetDuty;
+  uint16_t rampStep;           // Duty increase per timer tick
+  unsigned long manualUntil;   // millis() until local control may take over again
+  unsigned long onSince;       // millis() when the output was switched on
+  unsigned long runUntil;      // millis() of the planned end (0 = open ended)
+  bool tripped;                // Watchdog forced off, ignore "on" until released
+};
+
+static ActuatorState actuatorState[MAX_ACTUATORS];
+static Ticker rampTicker;
+
+static void writeDuty(uint8_t index, uint16_t duty) {
+  const ActuatorConfig& actuator = controlConfig.actuators[index];
+  actuatorState[index].duty = duty;
+
+  switch (actuator.type) {
+    case ACTUATOR_RELAY_NO:
+      digitalWrite(actuator.pin, duty > 0 ? HIGH : LOW);
+      break;
+    case ACTUATOR_RELAY_NC:
+      digitalWrite(actuator.pin, duty > 0 ? LOW : HIGH);
+      break;
+    case ACTUATOR_PWM:
+      analogWrite(actuator.pin, duty);
+      break;
+  }
+}
+
+// Timer callback: move ramping outputs one step towards their target
+static void stepRamps() {
+  bool ramping = false;
+
+  for (uint8_t i = 0; i < controlConfig.actuator_count; i++) {
+    ActuatorState& state = actuatorState[i];
+    if (state.duty >= state.targetDuty) continue;
+
+    uint16_t remaining = state.targetDuty - state.duty;
+    writeDuty(i, state.duty + min(remaining, state.rampStep));
+    ramping |= state.duty < state.targetDuty;
+  }
+
+  if (!ramping) {
+    rampTicker.detach();
+  }
+}
+
+void initializeActuators() {
+  rampTicker.detach();
+  memset(actuatorState, 0, sizeof(actuatorState));
+  analogWriteRange(PWM_MAX);
+
+  for (uint8_t i = 0; i < controlConfig.actuator_count; i++) {
+    const ActuatorConfig& actuator = controlConfig.actuators[i];
+    if (actuator.type == ACTUATOR_NONE) continue;
+
+    pinMode(actuator.pin, OUTPUT);
+    writeDuty(i, 0);  // Safe state until control or a command sets it
+
+    Serial.printf("Actuator %d: '%s' on GPIO%d (type %d, ramp %u ms)\n",
+                  i, actuator.actuator_id, actuator.pin, actuator.type, actuator.ramp_ms);
+  }
+}
+
+uint8_t findActuator(const char* actuatorId) {
+  for (uint8_t i = 0; i < controlConfig.actuator_count; i++) {
+    if (strcmp(controlConfig.actuators[i].actuator_id, actuatorId) == 0) {
+      return i;
+    }
+  }
+  return ACTUATOR_INVALID;
+}
+
+void setActuator(uint8_t index, float percent, uint32_t runMs) {
+  if (index >= controlConfig.actuator_count) {
+    return;
+  }
+
+  const ActuatorConfig& actuator = controlConfig.actuators[index];
+  ActuatorState& state = actuatorState[index];
+
+  percent = constrain(percent, 0.0f, 100.0f);
+  uint16_t target = (actuator.type == ACTUATOR_PWM)
+      ? (uint16_t)(percent * PWM_MAX / 100.0f + 0.5f)
+      : (percent > 0 ? PWM_MAX : 0);
+
+  // Off releases a watchdog trip; on stays ignored until then
+  if (target == 0) {
+    state.tripped = false;
+  } else if (state.tripped) {
+    return;
+  }
+
+  if (target > 0 && state.targetDuty == 0) {
+    state.onSince = millis();
+  }
+  state.runUntil = (target > 0 && runMs > 0) ? millis() + runMs : 0;
+  state.targetDuty = target;
+
+  // Decrease (and relays) apply at once; PWM increase ramps on the timer
+  if (target <= state.duty || actuator.type != ACTUATOR_PWM || actuator.ramp_ms < RAMP_STEP_MS) {
+    writeDuty(index, target);
+    return;
+  }
+
+  state.rampStep = max(1, (int)((uint32_t)PWM_MAX * RAMP_STEP_MS / actuator.ramp_ms));
+  if (!rampTicker.active()) {
+    rampTicker.attach_ms(RAMP_STEP_MS, stepRamps);
+  }
+}
+
+void setActuatorManual(uint8_t index, float percent) {
+  if (index >= controlConfig.actuator_count) {
+    return;
+  }
+  actuatorState[index].manualUntil = millis() + ACTUATOR_MANUAL_HOLD;
+  actuatorState[index].tripped = false;  // Explicit user action
+  setActuator(index, percent);
+}
+
+bool actuatorManualHold(uint8_t index) {
+  if (index >= controlConfig.actuator_count) {
+    return false;
+  }
+  unsigned long until = actuatorState[index].manualUntil;
+  return until != 0 && (long)(until - millis()) > 0;
+}
+
+void runActuatorWatchdogs() {
+  unsigned long now = millis();
+
+  for (uint8_t i = 0; i < controlConfig.actuator_count; i++) {
+    const ActuatorConfig& actuator = controlConfig.actuators[i];
+    ActuatorState& state = actuatorState[i];
+
+    if (state.targetDuty == 0 || actuator.max_on_s == 0 ||
+        now - state.onSince < actuator.max_on_s * 1000UL) {
+      continue;
+    }
+
+    Serial.printf("Actuator %d: '%s' on for more than %u s, forced off\n",
+                  i, actuator.actuator_id, actuator.max_on_s);
+    state.targetDuty = 0;
+    state.runUntil = 0;
+    state.tripped = true;
+    writeDuty(i, 0);
+  }
+}
+
+long actuatorRemainingSeconds(uint8_t index) {
+  if (index >= controlConfig.actuator_count || actuatorState[index].targetDuty == 0) {
+    return 0;
+  }
+
+  const ActuatorState& state = actuatorState[index];
+  unsigned long now = millis();
+  long remaining = -1;
+
+  if (state.runUntil != 0) {
+    remaining = max(0L, (long)(state.runUntil - now)) / 1000;
+  }
+
+  uint16_t maxOn = controlConfig.actuators[index].max_on_s;
+  if (maxOn > 0) {
+    long watchdog = max(0L, (long)(maxOn * 1000UL - (now - state.onSince))) / 1000;
+    if (remaining < 0 || watchdog < remaining) {
+      remaining = watchdog;
+    }
+  }
+
+  return remaining;
+}
+
+bool actuatorTripped(uint8_t index) {
+  return index < controlConfig.actuator_count && actuatorState[index].tripped;
+}
+
+float actuatorTarget(uint8_t index) {
+  if (index >= controlConfig.actuator_count) {
+    return 0;
+  }
+  return actuatorState[index].targetDuty * 100.0f / PWM_MAX;
+}
+
+float actuatorOutput(uint8_t index) {
+  if (index >= controlConfig.actuator_count) {
+    return 0;
+  }
+  return actuatorState[index].duty * 100.0f / PWM_MAX;
+}
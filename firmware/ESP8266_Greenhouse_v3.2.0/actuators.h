@@ -0,0 +1,47 @@
+#ifndef ACTUATORS_H
+#define ACTUATORS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Actuator outputs from controlConfig.actuators (fixed-index table).
+// Ids are resolved to indices once, when config or a command arrives;
+// everything at runtime (control loops, ramps) works on the index.
+// PWM outputs ramp up over ramp_ms on a timer (soft start), switching
+// off is always immediate.
+// Safety: an actuator on for longer than its max_on_s is switched off by
+// runActuatorWatchdogs(), whoever turned it on, and stays off until its
+// owner sets it to 0 (or a new manual command), so a lost "off" command
+// or a stuck rule cannot keep a pump running.
+
+#define ACTUATOR_INVALID 0xFF
+#define ACTUATOR_MANUAL_HOLD 900000  // Manual command overrides local control for 15 min
+
+// Configure pins and put every actuator in its off state
+void initializeActuators();
+
+// Index of actuator id, ACTUATOR_INVALID if not configured
+uint8_t findActuator(const char* actuatorId);
+
+// Set output 0-100% (relays: > 0 = on). PWM increases follow the ramp.
+// runMs: planned run time, reported as remaining time (0 = open ended)
+void setActuator(uint8_t index, float percent, uint32_t runMs = 0);
+
+// Manual command: set output and hold it against local control
+void setActuatorManual(uint8_t index, float percent);
+bool actuatorManualHold(uint8_t index);
+
+// Enforce max_on_s (every loop)
+void runActuatorWatchdogs();
+
+// Seconds until the actuator switches off by itself (0 = off, -1 = open ended)
+long actuatorRemainingSeconds(uint8_t index);
+
+// Switched off by the watchdog, waiting for its owner to release it
+bool actuatorTripped(uint8_t index);
+
+// Requested and current (ramping) output in %
+float actuatorTarget(uint8_t index);
+float actuatorOutput(uint8_t index);
+
+#endif
@@ -9,6 +9,20 @@
 #define CMD_RESET "reset"
 #define CMD_WIFI_UPDATE "wifi_update"
 #define CMD_FIRMWARE_UPDATE "firmware_update"
+#define CMD_RELAY_NO "relay_no"    // payload {actuator_id, on}
+#define CMD_RELAY_NC "relay_nc"    // payload {actuator_id, on}
+#define CMD_PWM "pwm"              // payload {actuator_id, value: 0-100}
+
+#define MAX_QUEUED_COMMANDS 4  // Max commands accepted per heartbeat
+
+// Background job status of the command being executed
+enum CommandJobStatus {
+  JOB_IDLE,
+  JOB_RUNNING,
+  JOB_SUCCEEDED,
+  JOB_FAILED,
+  JOB_TIMED_OUT
+};
 
 // Command structure
 struct DeviceCommand {
@@ -18,22 +32,50 @@ struct DeviceCommand {
   char password[64]; // For wifi_update
   char url[256];     // For firmware_update
   char version[16];  // For firmware_update
+  char sha256[65];   // For firmware_update (hex digest of the file at url)
+  char image_sha256[65];     // Digest of the image the device will run (LAN peers)
+  char delta_url[256];       // Optional binary delta against running image
+  char delta_sha256[65];     // Digest of the image produced by the delta
+  char delta_base_md5[33];   // MD5 of the image the delta was built against
+  char actuator_id[16];      // For relay_no / relay_nc / pwm
+  uint8_t value;             // Output in % (relays: 0 = off, 100 = on)
   bool valid;
 };
 
+// Command UUID <-> 16 raw bytes (compact storage in RTC memory)
+bool packUuid(const char* uuid, uint8_t* out);
+void unpackUuid(const uint8_t* in, char* out);
+
 // Parse command from heartbeat response JSON
 DeviceCommand parseCommand(const JsonObject& cmdJson);
 
-// Execute command (returns true if restart needed)
-bool executeCommand(const DeviceCommand& cmd);
+// Command queue (filled by heartbeat, drained in order from loop)
+bool enqueueCommand(const DeviceCommand& cmd);
+uint8_t queuedCommandCount();
 
-// Acknowledge command execution to server
+// Call every loop iteration: starts the next queued command as a background
+// job and advances the running one by one short step (never blocks for the
+// whole command). Restarts the device when a finished job requires it.
+void processCommandQueue();
+
+// Job currently running (or finished and waiting to restart)
+bool commandJobRunning();
+CommandJobStatus commandJobStatus();
+const char* commandJobType();
+const char* commandJobStatusName(CommandJobStatus status);
+
+// Record command result (persisted in RTC memory until flushed)
 void acknowledgeCommand(const char* commandId, bool success, const char* errorMessage = nullptr);
 
-// WiFi update with fallback
-bool updateWiFiCredentials(const char* newSsid, const char* newPassword);
+// Send all pending acknowledgements in one request
+bool flushCommandAcks();
+
+// Report progress of a running command (not persisted, best effort)
+void reportCommandProgress(const char* commandId, int percent);
 
-// OTA firmware update
-bool performOTAUpdate(const char* firmwareUrl, const char* version);
+// Report download size/time of a firmware update (best effort)
+// kind: "full", "delta" or "lan" (full image from a peer device)
+void reportCommandMetrics(const char* commandId, uint32_t downloadBytes,
+                          uint32_t downloadMs, const char* kind);
 
 #endif
@@ -4,6 +4,21 @@
 #include <WiFiManager.h>
 
 DeviceConfig deviceConfig;
+ControlConfig controlConfig;
+RuleProgram ruleProgram;
+ScheduleTable scheduleTable;
+CalibrationTable calibrationTable;
+RtcState rtcState;
+
+static_assert(EEPROM_OFFSET + sizeof(DeviceConfig) <= CONTROL_EEPROM_OFFSET, "DeviceConfig overlaps ControlConfig");
+static_assert(CONTROL_EEPROM_OFFSET + sizeof(ControlConfig) <= RULES_EEPROM_OFFSET, "ControlConfig overlaps RuleProgram");
+static_assert(RULES_EEPROM_OFFSET + sizeof(RuleProgram) <= SCHEDULES_EEPROM_OFFSET, "RuleProgram overlaps ScheduleTable");
+static_assert(SCHEDULES_EEPROM_OFFSET + sizeof(ScheduleTable) <= CALIBRATION_EEPROM_OFFSET, "ScheduleTable overlaps CalibrationTable");
+static_assert(CALIBRATION_EEPROM_OFFSET + sizeof(CalibrationTable) <= EEPROM_SIZE, "CalibrationTable does not fit in EEPROM");
+static_assert(MAX_RULE_CODE <= 255, "Rule code offsets are 8 bit");
+
+static_assert(sizeof(RtcState) % 4 == 0, "RtcState must be a multiple of 4 bytes");
+static_assert(RTC_STATE_OFFSET * 4 + sizeof(RtcState) <= 512, "RtcState does not fit in RTC user memory");
 extern WiFiManagerParameter* param_composite_id;
 
 uint32_t calculateCRC32(const uint8_t* data, size_t length) {
@@ -84,13 +99,212 @@ void saveConfig() {
 
 void clearConfig() {
   memset(&deviceConfig, 0, sizeof(DeviceConfig));
+  memset(&controlConfig, 0, sizeof(ControlConfig));
+  memset(&ruleProgram, 0, sizeof(RuleProgram));
+  memset(&scheduleTable, 0, sizeof(ScheduleTable));
+  memset(&calibrationTable, 0, sizeof(CalibrationTable));
   EEPROM.begin(EEPROM_SIZE);
   EEPROM.put(EEPROM_OFFSET, deviceConfig);
+  EEPROM.put(CONTROL_EEPROM_OFFSET, controlConfig);
+  EEPROM.put(RULES_EEPROM_OFFSET, ruleProgram);
+  EEPROM.put(SCHEDULES_EEPROM_OFFSET, scheduleTable);
+  EEPROM.put(CALIBRATION_EEPROM_OFFSET, calibrationTable);
   EEPROM.commit();
   EEPROM.end();
   Serial.println("Config erased from EEPROM");
 }
 
+// ========================================
+// Actuator / control loop config (separate EEPROM block)
+// ========================================
+
+void loadControlConfig() {
+  EEPROM.begin(EEPROM_SIZE);
+  EEPROM.get(CONTROL_EEPROM_OFFSET, controlConfig);
+  EEPROM.end();
+
+  uint32_t calculatedCRC = calculateCRC32(
+    (uint8_t*)&controlConfig,
+    sizeof(ControlConfig) - sizeof(uint32_t)
+  );
+
+  if (controlConfig.magic != CONTROL_CONFIG_MAGIC || calculatedCRC != controlConfig.crc32 ||
+      controlConfig.actuator_count > MAX_ACTUATORS || controlConfig.loop_count > MAX_CONTROL_LOOPS) {
+    Serial.println("No valid control config in EEPROM");
+    memset(&controlConfig, 0, sizeof(ControlConfig));
+
+    // Missing or older layout: fetch actuators again on next heartbeat
+    if (deviceConfig.config_version > 0) {
+      Serial.println("Resetting config_version to 0 to force cloud sync");
+      deviceConfig.config_version = 0;
+      saveConfig();
+    }
+    return;
+  }
+
+  Serial.printf("Control config loaded: %d actuator(s), %d loop(s)\n",
+                controlConfig.actuator_count, controlConfig.loop_count);
+}
+
+void saveControlConfig() {
+  controlConfig.magic = CONTROL_CONFIG_MAGIC;
+  controlConfig.crc32 = calculateCRC32(
+    (uint8_t*)&controlConfig,
+    sizeof(ControlConfig) - sizeof(uint32_t)
+  );
+
+  EEPROM.begin(EEPROM_SIZE);
+  EEPROM.put(CONTROL_EEPROM_OFFSET, controlConfig);
+  EEPROM.commit();
+  EEPROM.end();
+
+  Serial.println("Control config saved to EEPROM");
+}
+
+// ========================================
+// Rule program (separate EEPROM block)
+// ========================================
+
+void loadRuleProgram() {
+  EEPROM.begin(EEPROM_SIZE);
+  EEPROM.get(RULES_EEPROM_OFFSET, ruleProgram);
+  EEPROM.end();
+
+  uint32_t calculatedCRC = calculateCRC32(
+    (uint8_t*)&ruleProgram,
+    sizeof(RuleProgram) - sizeof(uint32_t)
+  );
+
+  if (ruleProgram.magic != RULES_CONFIG_MAGIC || calculatedCRC != ruleProgram.crc32 ||
+      ruleProgram.rule_count > MAX_RULES || ruleProgram.code_length > MAX_RULE_CODE) {
+    Serial.println("No valid rule program in EEPROM");
+    memset(&ruleProgram, 0, sizeof(RuleProgram));
+
+    // Written by a firmware without rules: fetch them on next heartbeat
+    if (deviceConfig.config_version > 0) {
+      Serial.println("Resetting config_version to 0 to force cloud sync");
+      deviceConfig.config_version = 0;
+      saveConfig();
+    }
+    return;
+  }
+
+  Serial.printf("Rule program loaded: %d rule(s), %d bytes\n",
+                ruleProgram.rule_count, ruleProgram.code_length);
+}
+
+void saveRuleProgram() {
+  ruleProgram.magic = RULES_CONFIG_MAGIC;
+  ruleProgram.crc32 = calculateCRC32(
+    (uint8_t*)&ruleProgram,
+    sizeof(RuleProgram) - sizeof(uint32_t)
+  );
+
+  EEPROM.begin(EEPROM_SIZE);
+  EEPROM.put(RULES_EEPROM_OFFSET, ruleProgram);
+  EEPROM.commit();
+  EEPROM.end();
+
+  Serial.println("Rule program saved to EEPROM");
+}
+
+// ========================================
+// Schedule table (separate EEPROM block)
+// ========================================
+
+void loadSchedules() {
+  EEPROM.begin(EEPROM_SIZE);
+  EEPROM.get(SCHEDULES_EEPROM_OFFSET, scheduleTable);
+  EEPROM.end();
+
+  uint32_t calculatedCRC = calculateCRC32(
+    (uint8_t*)&scheduleTable,
+    sizeof(ScheduleTable) - sizeof(uint32_t)
+  );
+
+  if (scheduleTable.magic != SCHEDULES_CONFIG_MAGIC || calculatedCRC != scheduleTable.crc32 ||
+      scheduleTable.count > MAX_SCHEDULES) {
+    Serial.println("No valid schedule table in EEPROM");
+    memset(&scheduleTable, 0, sizeof(ScheduleTable));
+
+    // Written by a firmware without schedules: fetch them on next heartbeat
+    if (deviceConfig.config_version > 0) {
+      Serial.println("Resetting config_version to 0 to force cloud sync");
+      deviceConfig.config_version = 0;
+      saveConfig();
+    }
+    return;
+  }
+
+  Serial.printf("Schedules loaded: %d\n", scheduleTable.count);
+}
+
+void saveSchedules() {
+  scheduleTable.magic = SCHEDULES_CONFIG_MAGIC;
+  scheduleTable.crc32 = calculateCRC32(
+    (uint8_t*)&scheduleTable,
+    sizeof(ScheduleTable) - sizeof(uint32_t)
+  );
+
+  EEPROM.begin(EEPROM_SIZE);
+  EEPROM.put(SCHEDULES_EEPROM_OFFSET, scheduleTable);
+  EEPROM.commit();
+  EEPROM.end();
+
+  Serial.println("Schedules saved to EEPROM");
+}
+
+// ========================================
+// Sensor calibration (separate EEPROM block)
+// ========================================
+
+void loadCalibration() {
+  EEPROM.begin(EEPROM_SIZE);
+  EEPROM.get(CALIBRATION_EEPROM_OFFSET, calibrationTable);
+  EEPROM.end();
+
+  uint32_t calculatedCRC = calculateCRC32(
+    (uint8_t*)&calibrationTable,
+    sizeof(CalibrationTable) - sizeof(uint32_t)
+  );
+
+  if (calibrationTable.magic != CALIBRATION_CONFIG_MAGIC || calculatedCRC != calibrationTable.crc32) {
+    Serial.println("No valid calibration in EEPROM");
+    memset(&calibrationTable, 0, sizeof(CalibrationTable));
+
+    // Written by a firmware without calibration: fetch it on next heartbeat
+    if (deviceConfig.config_version > 0) {
+      Serial.println("Resetting config_version to 0 to force cloud sync");
+      deviceConfig.config_version = 0;
+      saveConfig();
+    }
+    return;
+  }
+
+  int calibrated = 0;
+  for (int i = 0; i < MAX_SENSORS; i++) {
+    for (int c = 0; c < 2; c++) {
+      if (calibrationTable.sensors[i][c].mode != CALIBRATION_NONE) calibrated++;
+    }
+  }
+  Serial.printf("Calibration loaded: %d calibrated value(s)\n", calibrated);
+}
+
+void saveCalibration() {
+  calibrationTable.magic = CALIBRATION_CONFIG_MAGIC;
+  calibrationTable.crc32 = calculateCRC32(
+    (uint8_t*)&calibrationTable,
+    sizeof(CalibrationTable) - sizeof(uint32_t)
+  );
+
+  EEPROM.begin(EEPROM_SIZE);
+  EEPROM.put(CALIBRATION_EEPROM_OFFSET, calibrationTable);
+  EEPROM.commit();
+  EEPROM.end();
+
+  Serial.println("Calibration saved to EEPROM");
+}
+
 void generateDeviceKey() {
   // Generate 64-character hex string (32 random bytes)
   const char hexChars[] = "0123456789abcdef";
@@ -171,3 +385,40 @@ void restoreBackupWiFi() {
 bool hasValidWiFiBackup() {
   return deviceConfig.wifi_backup.valid && strlen(deviceConfig.wifi_backup.ssid) > 0;
 }
+
+// ============================================
+// RTC State Functions (survive soft restart)
+// ============================================
+
+void loadRtcState() {
+  ESP.rtcUserMemoryRead(RTC_STATE_OFFSET, (uint32_t*)&rtcState, sizeof(RtcState));
+
+  uint32_t calculatedCRC = calculateCRC32(
+    (uint8_t*)&rtcState,
+    sizeof(RtcState) - sizeof(uint32_t)
+  );
+
+  if (rtcState.magic != RTC_STATE_MAGIC || calculatedCRC != rtcState.crc32 ||
+      rtcState.ack_count > MAX_PENDING_ACKS ||
+      rtcState.recent_count > MAX_RECENT_COMMANDS ||
+      rtcState.recent_head >= MAX_RECENT_COMMANDS) {
+    // Cold boot (power on) or corrupted memory: start clean
+    Serial.println("RTC state invalid (cold boot), initializing");
+    memset(&rtcState, 0, sizeof(RtcState));
+    rtcState.magic = RTC_STATE_MAGIC;
+    saveRtcState();
+    return;
+  }
+
+  Serial.printf("RTC state loaded: %d pending acks, %d recent commands\n",
+                rtcState.ack_count, rtcState.recent_count);
+}
+
+void saveRtcState() {
+  rtcState.crc32 = calculateCRC32(
+    (uint8_t*)&rtcState,
+    sizeof(RtcState) - sizeof(uint32_t)
+  );
+
+  ESP.rtcUserMemoryWrite(RTC_STATE_OFFSET, (uint32_t*)&rtcState, sizeof(RtcState));
+}
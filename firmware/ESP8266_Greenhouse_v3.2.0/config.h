@@ -4,10 +4,42 @@
 #include <Arduino.h>
 #include <EEPROM.h>
 
-#define EEPROM_SIZE 768  // Increased for backup WiFi credentials
+#define FIRMWARE_VERSION "v3.2.0"
+
+#define EEPROM_SIZE 1536  // DeviceConfig + control block + rules + schedules + calibration
 #define EEPROM_OFFSET 0
 #define MAX_SENSORS 4
 
+// Actuators and local control loops live in their own EEPROM block after
+// DeviceConfig (DeviceConfig layout and CRC stay unchanged)
+#define CONTROL_EEPROM_OFFSET 448
+#define CONTROL_CONFIG_MAGIC 0x4333  // "C3"
+#define MAX_ACTUATORS 6
+#define MAX_CONTROL_LOOPS 4
+
+// Compiled automation rules (rules.cpp), own block after ControlConfig
+#define RULES_EEPROM_OFFSET 704
+#define RULES_CONFIG_MAGIC 0x5231  // "R1"
+#define MAX_RULES 8
+#define MAX_RULE_CODE 192          // Bytecode bytes shared by all rules
+
+// Scheduled actions (schedules.cpp), own block after RuleProgram
+#define SCHEDULES_EEPROM_OFFSET 976
+#define SCHEDULES_CONFIG_MAGIC 0x5331  // "S1"
+#define MAX_SCHEDULES 8
+
+// Sensor calibration (sample.cpp), own block after ScheduleTable
+#define CALIBRATION_EEPROM_OFFSET 1112
+#define CALIBRATION_CONFIG_MAGIC 0x4B31  // "K1"
+#define MAX_CALIBRATION_POINTS 8
+
+// RTC user memory survives ESP.restart() and OTA reboots (not power loss).
+// The first 128 bytes (32 blocks) are overwritten by the OTA bootloader.
+#define RTC_STATE_OFFSET 32
+#define RTC_STATE_MAGIC 0x53525432  // "SRT2"
+#define MAX_PENDING_ACKS 4
+#define MAX_RECENT_COMMANDS 8  // Executed command ids remembered for dedup
+
 // Sensor pin configuration
 struct SensorPin {
   uint8_t pin;           // GPIO pin number (0 = not configured)
@@ -34,7 +66,169 @@ struct DeviceConfig {
   uint32_t crc32;                // CRC32 checksum
 };
 
+// Actuator output types (same values as the WebConfig sketch)
+enum ActuatorType {
+  ACTUATOR_NONE = 0,
+  ACTUATOR_RELAY_NO = 1,  // Normally Open
+  ACTUATOR_RELAY_NC = 2,  // Normally Closed
+  ACTUATOR_PWM = 3
+};
+
+enum ControlMode {
+  CONTROL_NONE = 0,
+  CONTROL_HYSTERESIS = 1,  // On/off thermostat (relays, fans)
+  CONTROL_PID = 2          // Proportional output (ACTUATOR_PWM only)
+};
+
+enum ControlInput {
+  CONTROL_INPUT_TEMPERATURE = 0,
+  CONTROL_INPUT_HUMIDITY = 1
+};
+
+// Actuator output (index in the table is used everywhere at runtime)
+struct ActuatorConfig {
+  char actuator_id[16];  // Cloud actuator id (e.g. "fan_1")
+  uint8_t type;          // ActuatorType
+  uint8_t pin;           // GPIO pin
+  uint16_t ramp_ms;      // PWM soft-start time 0 -> 100% (0 = immediate)
+  uint16_t max_on_s;     // Safety limit for continuous on time (0 = none)
+};
+
+// One closed loop: sensor reading -> actuator output
+struct ControlLoop {
+  uint8_t actuator_index; // Index into controlConfig.actuators
+  uint8_t mode;           // ControlMode
+  uint8_t sensor_index;   // Index into deviceConfig.sensors
+  uint8_t input;          // ControlInput
+  uint8_t cooling;        // 1 = output lowers the input (fan), 0 = raises it (heater)
+  uint8_t reserved[3];
+  float setpoint;
+  float hysteresis;      // Total band width around setpoint
+  float kp;              // PID gains, output in % (0-100)
+  float ki;
+  float kd;
+};
+
+// Actuators and control loops stored in EEPROM (synced from cloud config)
+struct ControlConfig {
+  uint16_t magic;        // CONTROL_CONFIG_MAGIC
+  uint8_t actuator_count;
+  uint8_t loop_count;
+  ActuatorConfig actuators[MAX_ACTUATORS];
+  ControlLoop loops[MAX_CONTROL_LOOPS];
+  uint32_t crc32;        // CRC32 checksum
+};
+
+// One automation rule: condition bytecode -> actuator output
+struct RuleConfig {
+  uint8_t actuator_index; // Index into controlConfig.actuators
+  uint8_t value;          // Output % while active
+  uint16_t duration_s;    // 0 = follow the condition, > 0 = pulse on rising edge
+  uint8_t code_offset;    // Start of the condition in RuleProgram.code
+  uint8_t code_length;    // Bytecode length in bytes
+  uint8_t instructions;   // Instruction count (charged against the tick budget)
+  uint8_t reserved;
+};
+
+// Rule program stored in EEPROM (compiled from cloud config on sync)
+struct RuleProgram {
+  uint16_t magic;        // RULES_CONFIG_MAGIC
+  uint8_t rule_count;
+  uint8_t code_length;   // Used bytes of code[]
+  RuleConfig rules[MAX_RULES];
+  uint8_t code[MAX_RULE_CODE];
+  uint32_t crc32;        // CRC32 checksum
+};
+
+// What to do with a run that was missed while the device was off
+enum MissedRunPolicy {
+  MISSED_SKIP = 0,      // Wait for the next start
+  MISSED_RESUME = 1,    // Inside the window: run for the remaining time
+  MISSED_CATCH_UP = 2   // Resume, or run the full duration if missed < 6 h ago
+};
+
+// One timer: start at local time of day on the selected weekdays
+struct ScheduleEntry {
+  uint8_t actuator_index; // Index into controlConfig.actuators
+  uint8_t weekdays;       // Bit 0 = Sunday ... bit 6 = Saturday
+  uint8_t value;          // Output % while running
+  uint8_t missed_policy;  // MissedRunPolicy
+  uint32_t start_s;       // Seconds after local midnight (0 - 86399)
+  uint32_t last_run;      // Epoch seconds of the last start (catch-up), 0 = no history yet
+  uint16_t duration_s;
+  uint8_t reserved[2];
+};
+
+// Schedule table stored in EEPROM (synced from cloud config)
+struct ScheduleTable {
+  uint16_t magic;        // SCHEDULES_CONFIG_MAGIC
+  uint8_t count;
+  uint8_t reserved;
+  ScheduleEntry entries[MAX_SCHEDULES];
+  uint32_t crc32;        // CRC32 checksum
+};
+
+enum CalibrationMode {
+  CALIBRATION_NONE = 0,
+  CALIBRATION_LINEAR = 1,   // value * gain + offset
+  CALIBRATION_TABLE = 2     // Piecewise linear through the points
+};
+
+// Correction of one sensor value, in its fixed-point units (sample.h)
+struct SensorCalibration {
+  uint8_t mode;           // CalibrationMode
+  uint8_t point_count;    // CALIBRATION_TABLE: 2 - MAX_CALIBRATION_POINTS
+  int16_t offset;         // CALIBRATION_LINEAR
+  int16_t gain;           // CALIBRATION_LINEAR, permille (1000 = 1.0)
+  int16_t raw[MAX_CALIBRATION_POINTS];    // Measured, strictly ascending
+  int16_t value[MAX_CALIBRATION_POINTS];  // Corrected
+};
+
+// Calibration of every sensor slot stored in EEPROM (synced with the
+// sensor config). Channel 0 = temperature / main value, 1 = humidity.
+struct CalibrationTable {
+  uint16_t magic;        // CALIBRATION_CONFIG_MAGIC
+  uint8_t reserved[2];
+  SensorCalibration sensors[MAX_SENSORS][2];
+  uint32_t crc32;        // CRC32 checksum
+};
+
+// Command acknowledgement waiting to be sent (UUID stored as 16 raw bytes)
+struct PendingAck {
+  uint8_t command_id[16];
+  bool success;
+  char error_message[31];
+};
+
+// Recently executed command (ring entry)
+struct RecentCommand {
+  uint8_t command_id[16];
+  bool success;
+};
+
+// State kept in RTC memory across soft restarts
+struct RtcState {
+  uint32_t magic;
+  uint8_t ack_count;
+  uint8_t recent_count;
+  uint8_t recent_head;                // Next ring slot to overwrite
+  uint8_t reserved;
+  PendingAck acks[MAX_PENDING_ACKS];  // Acks not yet delivered to server
+  RecentCommand recent[MAX_RECENT_COMMANDS];  // Ring of executed command ids
+  uint8_t ota_command_id[16];         // firmware_update awaiting confirmation
+  char ota_version[12];               // Version the OTA should boot into
+  uint8_t ota_pending;                // 1 = new image not confirmed healthy yet
+  uint8_t boot_attempts;              // Boots since OTA without confirmation
+  uint8_t reserved2[2];
+  uint32_t crc32;                     // CRC32 checksum
+};
+
 extern DeviceConfig deviceConfig;
+extern ControlConfig controlConfig;
+extern RuleProgram ruleProgram;
+extern ScheduleTable scheduleTable;
+extern CalibrationTable calibrationTable;
+extern RtcState rtcState;
 
 // Functions
 void loadConfig();
@@ -50,4 +244,18 @@ void backupCurrentWiFi();
 void restoreBackupWiFi();
 bool hasValidWiFiBackup();
 
+// Actuator / control loop config functions
+void loadControlConfig();
+void saveControlConfig();
+void loadRuleProgram();
+void saveRuleProgram();
+void loadSchedules();
+void saveSchedules();
+void loadCalibration();
+void saveCalibration();
+
+// RTC state functions
+void loadRtcState();
+void saveRtcState();
+
 #endif
@@ -0,0 +1,143 @@
+#include "control.h"
+#include "sensors.h"
+#include "actuators.h"
+
+#define CONTROL_STALE_READING 90000  // Reading older than 3 samples = sensor lost
+
+// Runtime state per loop (not persisted)
+struct ControlState {
+  float output;            // 0-100 %
+  float integral;          // PID integral term (already scaled by ki)
+  float lastInput;
+  bool hasLastInput;
+  unsigned long lastRun;
+};
+
+static ControlState controlState[MAX_CONTROL_LOOPS];
+
+void initializeControl() {
+  memset(controlState, 0, sizeof(controlState));
+
+  for (int i = 0; i < controlConfig.loop_count; i++) {
+    const ControlLoop& loop = controlConfig.loops[i];
+
+    uint16_t scale = loop.input == CONTROL_INPUT_HUMIDITY ? SCALE_HUMIDITY : SCALE_TEMPERATURE;
+    char setpoint[12];
+    formatFixed(setpoint, sizeof(setpoint), toFixed(loop.setpoint, scale), scale);
+
+    Serial.printf("Control %d: %s, %s, setpoint %s (%s)\n",
+                  i, controlConfig.actuators[loop.actuator_index].actuator_id,
+                  loop.mode == CONTROL_PID ? "PID" : "hysteresis",
+                  setpoint, loop.cooling ? "cooling" : "heating");
+  }
+}
+
+// Positive error = output needs to act
+static float loopError(const ControlLoop& loop, float input) {
+  return loop.cooling ? (input - loop.setpoint) : (loop.setpoint - input);
+}
+
+static float stepHysteresis(const ControlLoop& loop, ControlState& state, float input) {
+  float error = loopError(loop, input);
+  float halfBand = loop.hysteresis / 2;
+
+  if (error > halfBand) {
+    return 100;
+  }
+  if (error < -halfBand) {
+    return 0;
+  }
+  return state.output;  // Inside the band: keep current state
+}
+
+static float stepPid(const ControlLoop& loop, ControlState& state, float input, float dt) {
+  float error = loopError(loop, input);
+
+  // Derivative on measurement: no kick when the setpoint changes
+  float derivative = 0;
+  if (state.hasLastInput && dt > 0) {
+    float change = (input - state.lastInput) / dt;
+    derivative = loop.cooling ? change : -change;
+  }
+
+  float proportional = loop.kp * error;
+  float integral = state.integral + loop.ki * error * dt;
+  float output = proportional + integral + loop.kd * derivative;
+
+  // Anti-windup: only keep the integral while the output is not saturated
+  // (or when it pulls the output back into range)
+  if ((output <= 100 || error < 0) && (output >= 0 || error > 0)) {
+    state.integral = constrain(integral, 0.0f, 100.0f);
+  }
+
+  return constrain(output, 0.0f, 100.0f);
+}
+
+void runControlLoops() {
+  unsigned long now = millis();
+
+  for (int i = 0; i < controlConfig.loop_count; i++) {
+    const ControlLoop& loop = controlConfig.loops[i];
+    ControlState& state = controlState[i];
+
+    if (loop.actuator_index >= controlConfig.actuator_count || loop.sensor_index >= MAX_SENSORS) {
+      continue;
+    }
+
+    const ActuatorConfig& actuator = controlConfig.actuators[loop.actuator_index];
+
+    // Manual command in effect: restart cleanly once the hold expires
+    if (actuatorManualHold(loop.actuator_index)) {
+      state.output = actuatorTarget(loop.actuator_index);
+      state.hasLastInput = false;
+      state.lastRun = 0;
+      continue;
+    }
+
+    const SensorReading& reading = sensorReadings[loop.sensor_index];
+    if (reading.readAt == 0 || now - reading.readAt > CONTROL_STALE_READING) {
+      // Sensor lost: fail safe, actuator off
+      if (state.output > 0) {
+        Serial.printf("Control %d: no valid reading, %s off\n", i, actuator.actuator_id);
+      }
+      state.output = 0;
+      state.hasLastInput = false;
+      setActuator(loop.actuator_index, 0);
+      continue;
+    }
+
+    bool humidity = loop.input == CONTROL_INPUT_HUMIDITY;
+    int32_t fixedInput = humidity ? reading.humidity : reading.temperature;
+    uint16_t scale = humidity ? SCALE_HUMIDITY : SCALE_TEMPERATURE;
+    float input = fromFixed(fixedInput, scale);
+    float dt = state.lastRun > 0 ? (now - state.lastRun) / 1000.0f : 0;
+
+    float output;
+    if (loop.mode == CONTROL_PID && actuator.type == ACTUATOR_PWM) {
+      output = stepPid(loop, state, input, dt);
+    } else {
+      output = stepHysteresis(loop, state, input);
+    }
+
+    if (output != state.output) {
+      char text[12], setpoint[12];
+      formatFixed(text, sizeof(text), fixedInput, scale);
+      formatFixed(setpoint, sizeof(setpoint), toFixed(loop.setpoint, scale), scale);
+      Serial.printf("Control %d: %s %d%% (input %s, setpoint %s)\n",
+                    i, actuator.actuator_id, (int)lroundf(output), text, setpoint);
+    }
+
+    state.output = output;
+    state.lastInput = input;
+    state.hasLastInput = true;
+    state.lastRun = now;
+    setActuator(loop.actuator_index, output);
+  }
+}
+
+float controlOutput(int loopIndex) {
+  if (loopIndex < 0 || loopIndex >= controlConfig.loop_count) {
+    return 0;
+  }
+  return controlState[loopIndex].output;
+}
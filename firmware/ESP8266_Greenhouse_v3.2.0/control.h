@@ -0,0 +1,23 @@
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Local closed-loop control: runs on every sensor sample, independent of
+// WiFi and cloud. Loops and setpoints come from cloud config (EEPROM copy).
+//   CONTROL_HYSTERESIS: on/off around setpoint (relays, fans)
+//   CONTROL_PID:        0-100% output on ACTUATOR_PWM pins
+// Outputs go through actuators.h; actuators under a manual command hold
+// are skipped until the hold expires.
+
+// Reset loop state (after config changes, call initializeActuators first)
+void initializeControl();
+
+// One control step from the latest sensorReadings[]
+void runControlLoops();
+
+// Current output of loop i in % (0 = off)
+float controlOutput(int loopIndex);
+
+#endif
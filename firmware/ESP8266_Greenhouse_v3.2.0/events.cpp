@@ -0,0 +1,147 @@
+#include "events.h"
+#include "webserver.h"
+#include "sensors.h"
+#include "actuators.h"
+#include "timesync.h"
+#include <ArduinoJson.h>
+
+// Last published state per actuator, to detect changes
+struct ActuatorEventState {
+  int target;
+  bool manual;
+  bool tripped;
+};
+
+static AsyncEventSource events("/events");
+static AsyncEventSourceClient* eventClients[EVENT_MAX_CLIENTS];
+static ActuatorEventState actuatorEventState[MAX_ACTUATORS];
+static uint32_t publishedDataVersion = 0;
+
+// JSON data of one event (nullptr if it does not fit)
+static const char* formatEvent(char* message, size_t size, const JsonDocument& data) {
+  return serializeJson(data, message, size) < size - 1 ? message : nullptr;
+}
+
+static const char* formatActuator(char* message, size_t size, uint8_t index) {
+  StaticJsonDocument<160> data;
+  data["actuator_id"] = controlConfig.actuators[index].actuator_id;
+  data["target"] = actuatorEventState[index].target;
+  data["output"] = (int)(actuatorOutput(index) + 0.5f);
+  data["manual"] = actuatorEventState[index].manual;
+  data["tripped"] = actuatorEventState[index].tripped;
+  data["remaining_s"] = actuatorRemainingSeconds(index);
+  return formatEvent(message, size, data);
+}
+
+// Runs in the TCP stack's context when a browser connects
+static void onEventClientConnect(AsyncEventSourceClient* client) {
+  int slot = -1;
+  for (int i = 0; i < EVENT_MAX_CLIENTS; i++) {
+    if (eventClients[i] == nullptr) {
+      slot = i;
+      break;
+    }
+  }
+
+  if (slot < 0) {
+    Serial.println("Events: too many clients, connection closed");
+    client->close();
+    return;
+  }
+
+  eventClients[slot] = client;
+  Serial.printf("Events: client %s connected\n", client->client()->remoteIP().toString().c_str());
+
+  // Current actuator states (the first message also sets the retry delay),
+  // samples follow as they arrive
+  char message[192];
+  client->send("connected", nullptr, 0, EVENT_RETRY_MS);
+  for (uint8_t i = 0; i < controlConfig.actuator_count; i++) {
+    if (formatActuator(message, sizeof(message), i)) {
+      client->send(message, "actuator");
+    }
+  }
+}
+
+static void onEventClientDisconnect(AsyncEventSourceClient* client) {
+  for (int i = 0; i < EVENT_MAX_CLIENTS; i++) {
+    if (eventClients[i] == client) {
+      eventClients[i] = nullptr;
+    }
+  }
+}
+
+// Drop clients that do not keep up, then queue the message for the rest
+static void publish(const char* message, const char* event) {
+  for (int i = 0; i < EVENT_MAX_CLIENTS; i++) {
+    AsyncEventSourceClient* client = eventClients[i];
+    if (client != nullptr && client->packetsWaiting() >= EVENT_MAX_QUEUED) {
+      Serial.printf("Events: client %s too slow, dropped\n", client->client()->remoteIP().toString().c_str());
+      eventClients[i] = nullptr;
+      client->close();
+    }
+  }
+  events.send(message, event);
+}
+
+static void publishSample(const ReadingSample& sample) {
+  StaticJsonDocument<224> data;
+  data["slot"] = sample.slot + 1;
+  data["name"] = deviceConfig.sensors[sample.slot].name;
+  setFixed(data.as<JsonObject>(), "temperature", sample.temperature, SCALE_TEMPERATURE);
+  setFixed(data.as<JsonObject>(), "humidity", sample.humidity, SCALE_HUMIDITY);
+
+  char ts[32];
+  if (formatTimestamp(sample.readAt, ts, sizeof(ts))) {
+    data["ts"] = ts;
+  } else {
+    data["uptime_ms"] = sample.readAt;
+  }
+
+  char message[192];
+  if (formatEvent(message, sizeof(message), data)) {
+    publish(message, "sample");
+  }
+}
+
+void setupEvents() {
+  events.onConnect(onEventClientConnect);
+  events.onDisconnect(onEventClientDisconnect);
+  server.addHandler(&events);
+}
+
+void handleEvents() {
+  bool listening = false;
+  for (int i = 0; i < EVENT_MAX_CLIENTS; i++) {
+    listening |= eventClients[i] != nullptr;
+  }
+
+  // New samples since the last call, from the history ring
+  uint32_t newSamples = sensorDataVersion - publishedDataVersion;
+  publishedDataVersion = sensorDataVersion;
+  if (listening) {
+    uint8_t count = readingHistoryCount();
+    if (newSamples > count) newSamples = count;
+    for (uint8_t i = count - newSamples; i < count; i++) {
+      publishSample(readingHistoryAt(i));
+    }
+  }
+
+  // Actuator changes (requested output, manual hold, safety trip)
+  char message[192];
+  for (uint8_t i = 0; i < controlConfig.actuator_count; i++) {
+    ActuatorEventState& state = actuatorEventState[i];
+    int target = (int)(actuatorTarget(i) + 0.5f);
+    bool manual = actuatorManualHold(i);
+    bool tripped = actuatorTripped(i);
+
+    if (target == state.target && manual == state.manual && tripped == state.tripped) continue;
+
+    state.target = target;
+    state.manual = manual;
+    state.tripped = tripped;
+    if (listening && formatActuator(message, sizeof(message), i)) {
+      publish(message, "actuator");
+    }
+  }
+}
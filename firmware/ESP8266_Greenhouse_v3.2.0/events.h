@@ -0,0 +1,25 @@
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <Arduino.h>
+
+// Server-Sent Events stream (/events) for dashboards on the LAN: every new
+// sample ("sample") and actuator change ("actuator") is pushed as it
+// happens, without reloading a page.
+// Up to EVENT_MAX_CLIENTS connections. Each client has its own message
+// queue in the async server, sent as the TCP window allows, so a slow
+// client never blocks loop(). A client with EVENT_MAX_QUEUED messages still
+// unsent is dropped (EventSource reconnects by itself and gets the current
+// states again).
+
+#define EVENT_MAX_CLIENTS 3
+#define EVENT_MAX_QUEUED 8         // Unsent messages per client before it is dropped
+#define EVENT_RETRY_MS 5000        // Reconnect delay sent to the browser
+
+// Register /events on the web server
+void setupEvents();
+
+// Publish new samples / actuator changes (every loop)
+void handleEvents();
+
+#endif
@@ -9,7 +9,7 @@
 struct HeartbeatResponse {
   bool success;
   int config_version;
-  DeviceCommand command;  // Pending command from server
+  uint8_t commands_queued;  // Pending commands added to command queue
 };
 
 HeartbeatResponse sendHeartbeat();
@@ -0,0 +1,447 @@
+#include "history.h"
+#include "sensors.h"
+#include "timesync.h"
+
+#define HISTORY_POINT_MAX_LEN 48   // "[4294967295,-327.68,-327.68,-327.68],"
+#define HISTORY_END_OF_SEGMENTS 0xFFFFFFFFUL
+
+enum HistoryPart {
+  HISTORY_PART_HEADER,
+  HISTORY_PART_POINTS,
+  HISTORY_PART_FOOTER,
+  HISTORY_PART_DONE
+};
+
+// Segment table (sparse time index), sorted by hour
+static uint32_t segmentHours[HISTORY_MAX_SEGMENTS];
+static uint16_t segmentSizes[HISTORY_MAX_SEGMENTS];
+static uint8_t segmentCount = 0;
+
+static bool historyReady = false;
+static uint32_t historyBudget = 0;      // Bytes of filesystem blocks
+static uint32_t blockSize = 8192;
+
+// Records not yet on flash (all in pendingHour)
+static HistoryRecord pendingRecords[HISTORY_PENDING_RECORDS];
+static uint8_t pendingCount = 0;
+static uint32_t pendingHour = 0;
+static unsigned long lastFlush = 0;
+static unsigned long storedAt[MAX_SENSORS];  // readAt of the last buffered sample
+static uint8_t blockBuffer[HISTORY_BLOCK_MAX];
+
+static void segmentPath(char* path, size_t size, uint32_t hour) {
+  snprintf(path, size, HISTORY_DIR "/%lu.bin", (unsigned long)hour);
+}
+
+static uint32_t allocated(uint32_t size) {
+  return (size + blockSize - 1) / blockSize * blockSize;
+}
+
+// Index of the first segment with hour >= hour (segmentCount if none)
+static uint8_t firstSegmentFrom(uint32_t hour) {
+  uint8_t low = 0;
+  uint8_t high = segmentCount;
+  while (low < high) {
+    uint8_t mid = (low + high) / 2;
+    if (segmentHours[mid] < hour) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+static void insertSegment(uint32_t hour, uint32_t size) {
+  uint8_t index = firstSegmentFrom(hour);
+  memmove(&segmentHours[index + 1], &segmentHours[index], (segmentCount - index) * sizeof(segmentHours[0]));
+  memmove(&segmentSizes[index + 1], &segmentSizes[index], (segmentCount - index) * sizeof(segmentSizes[0]));
+  segmentHours[index] = hour;
+  segmentSizes[index] = size;
+  segmentCount++;
+}
+
+static void removeOldestSegment() {
+  char path[32];
+  segmentPath(path, sizeof(path), segmentHours[0]);
+  LittleFS.remove(path);
+
+  segmentCount--;
+  memmove(&segmentHours[0], &segmentHours[1], segmentCount * sizeof(segmentHours[0]));
+  memmove(&segmentSizes[0], &segmentSizes[1], segmentCount * sizeof(segmentSizes[0]));
+}
+
+// Delete the oldest segments until the history fits its budget
+// (newSegment: also make room in the table for one more)
+static void enforceRetention(bool newSegment) {
+  uint32_t used = 0;
+  for (uint8_t i = 0; i < segmentCount; i++) {
+    used += allocated(segmentSizes[i]);
+  }
+
+  uint8_t maxSegments = newSegment ? HISTORY_MAX_SEGMENTS - 1 : HISTORY_MAX_SEGMENTS;
+  uint32_t budget = newSegment ? historyBudget - min(historyBudget, blockSize) : historyBudget;
+
+  while (segmentCount > 0 && (used > budget || segmentCount > maxSegments)) {
+    Serial.printf("History: segment %lu removed (retention)\n", (unsigned long)segmentHours[0]);
+    used -= allocated(segmentSizes[0]);
+    removeOldestSegment();
+  }
+}
+
+void initializeHistory() {
+  if (!LittleFS.begin()) {
+    Serial.println("History: filesystem not available, disabled");
+    return;
+  }
+
+  // Budget: never take the space the OTA backup of the running image needs
+  FSInfo info;
+  LittleFS.info(info);
+  blockSize = info.blockSize;
+  uint32_t reserved = ESP.getSketchSize() + HISTORY_FS_RESERVE;
+  if (info.totalBytes <= reserved + 4 * blockSize) {
+    Serial.printf("History: filesystem too small (%u bytes), disabled\n", (unsigned)info.totalBytes);
+    return;
+  }
+  historyBudget = min((uint32_t)HISTORY_MAX_BYTES, (uint32_t)(info.totalBytes - reserved));
+
+  LittleFS.mkdir(HISTORY_DIR);
+  segmentCount = 0;
+  Dir dir = LittleFS.openDir(HISTORY_DIR);
+  while (dir.next()) {
+    uint32_t hour = strtoul(dir.fileName().c_str(), nullptr, 10);
+    if (hour == 0 || segmentCount == HISTORY_MAX_SEGMENTS || dir.fileSize() > UINT16_MAX) {
+      String path = String(HISTORY_DIR "/") + dir.fileName();
+      LittleFS.remove(path);
+      continue;
+    }
+    insertSegment(hour, dir.fileSize());
+  }
+
+  enforceRetention(false);
+  lastFlush = millis();
+  historyReady = true;
+  Serial.printf("History: %d segments, budget %u bytes\n", segmentCount, historyBudget);
+}
+
+// Encode the pending samples of one sensor into as many blocks as needed
+static bool writeBlocks(File& f, uint8_t slot) {
+  uint8_t next = 0;
+
+  while (true) {
+    SeriesEncoder encoder;
+    seriesBegin(encoder, blockBuffer, sizeof(blockBuffer), 2);
+    HistoryBlockHeader header = {0, 0, 0, slot, 0};
+
+    for (; next < pendingCount; next++) {
+      const HistoryRecord& record = pendingRecords[next];
+      if (record.slot != slot) continue;
+
+      int32_t values[2] = {record.temperature, record.humidity};
+      if (encoder.count == UINT8_MAX || !seriesAppend(encoder, record.second, values)) {
+        break;  // Block full, the record starts the next one
+      }
+      if (encoder.count == 1) {
+        header.first_second = record.second;
+      }
+      header.last_second = record.second;
+    }
+
+    if (encoder.count == 0) {
+      return true;
+    }
+
+    header.count = encoder.count;
+    header.length = seriesLength(encoder);
+    if (f.write((const uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        f.write(blockBuffer, header.length) != header.length) {
+      return false;
+    }
+  }
+}
+
+static void flushHistory() {
+  char path[32];
+  segmentPath(path, sizeof(path), pendingHour);
+
+  uint8_t index = firstSegmentFrom(pendingHour);
+  bool newSegment = index == segmentCount || segmentHours[index] != pendingHour;
+  if (newSegment) {
+    enforceRetention(true);
+  }
+
+  File f = LittleFS.open(path, "a");
+  if (!f) {
+    Serial.printf("History: cannot open %s, %d records lost\n", path, pendingCount);
+    pendingCount = 0;
+    return;
+  }
+
+  for (uint8_t slot = 0; slot < MAX_SENSORS; slot++) {
+    if (!writeBlocks(f, slot)) {
+      Serial.printf("History: write to %s failed\n", path);
+      break;
+    }
+  }
+  uint32_t size = f.size();
+  f.close();
+
+  if (newSegment) {
+    insertSegment(pendingHour, size);
+  } else {
+    segmentSizes[firstSegmentFrom(pendingHour)] = size;
+  }
+
+  pendingCount = 0;
+  lastFlush = millis();
+  enforceRetention(false);
+}
+
+void storeHistory() {
+  if (!historyReady) {
+    return;
+  }
+
+  for (uint8_t i = 0; i < MAX_SENSORS; i++) {
+    const SensorReading& reading = sensorReadings[i];
+    if (!reading.valid || reading.readAt == storedAt[i]) continue;
+
+    storedAt[i] = reading.readAt;
+    if (!timeSynced()) continue;
+
+    uint32_t time = epochMsAt(reading.readAt) / 1000;
+    uint32_t hour = time / 3600;
+    if (pendingCount > 0 && (hour != pendingHour || pendingCount == HISTORY_PENDING_RECORDS)) {
+      flushHistory();
+    }
+
+    HistoryRecord& record = pendingRecords[pendingCount++];
+    record.second = time - hour * 3600;
+    record.slot = i;
+    record.reserved = 0;
+    record.temperature = reading.temperature;
+    record.humidity = reading.humidity * (100 / SCALE_HUMIDITY);
+    pendingHour = hour;
+  }
+
+  if (pendingCount > 0 && millis() - lastFlush >= HISTORY_FLUSH_INTERVAL) {
+    flushHistory();
+  }
+}
+
+// ========================================
+// Range queries
+// ========================================
+
+bool beginHistoryQuery(HistoryQuery& query, const char* sensor,
+                       uint32_t from, uint32_t to, uint32_t step) {
+  if (!historyReady || !timeSynced() || !findSensor(sensor, &query.slot, &query.humidity)) {
+    return false;
+  }
+
+  uint32_t now = epochMsAt(millis()) / 1000;
+  query.to = to ? to : now + 1;
+  query.from = from ? from : query.to - 86400;
+  if (query.from >= query.to) {
+    return false;
+  }
+  if (query.to - query.from > HISTORY_MAX_RANGE) {
+    query.from = query.to - HISTORY_MAX_RANGE;
+  }
+
+  // At most HISTORY_MAX_POINTS buckets
+  uint32_t minStep = (query.to - query.from + HISTORY_MAX_POINTS - 1) / HISTORY_MAX_POINTS;
+  query.step = max(max(step, minStep), (uint32_t)1);
+
+  // Segments as they are now; records appended later are copied below
+  query.part = HISTORY_PART_HEADER;
+  query.hour = 0;
+  query.lastHour = segmentCount > 0 ? segmentHours[segmentCount - 1] : 0;
+  query.lastSize = segmentCount > 0 ? segmentSizes[segmentCount - 1] : 0;
+  query.fileEnd = 0;
+  query.decoder.remaining = 0;
+
+  query.pendingHour = pendingHour;
+  query.pendingCount = 0;
+  query.pendingRead = 0;
+  for (uint8_t i = 0; i < pendingCount; i++) {
+    if (pendingRecords[i].slot == query.slot) {
+      query.pending[query.pendingCount++] = pendingRecords[i];
+    }
+  }
+
+  query.lookahead = false;
+  query.firstPoint = true;
+  return true;
+}
+
+static uint32_t recordTime(uint32_t hour, uint16_t second) {
+  return hour * 3600 + second;
+}
+
+// Next block of the query's sensor and range in the open segment
+// (blocks of other sensors or outside the range are skipped unread)
+static bool nextBlock(HistoryQuery& query) {
+  HistoryBlockHeader header;
+
+  while (query.file.position() + sizeof(header) <= query.fileEnd &&
+         query.file.read((uint8_t*)&header, sizeof(header)) == sizeof(header)) {
+    if (header.length > sizeof(query.block) || query.file.position() + header.length > query.fileEnd) {
+      Serial.printf("History: corrupt block in segment %lu\n", (unsigned long)query.hour);
+      return false;
+    }
+
+    if (header.slot != query.slot ||
+        recordTime(query.hour, header.last_second) < query.from ||
+        recordTime(query.hour, header.first_second) >= query.to) {
+      query.file.seek(header.length, SeekCur);
+      continue;
+    }
+
+    if (query.file.read(query.block, header.length) != header.length) {
+      return false;
+    }
+    seriesDecodeBegin(query.decoder, query.block, header.length, 2, header.count);
+    return true;
+  }
+  return false;
+}
+
+// Next stored sample of the query's sensor in time order: segments, then
+// the unflushed copy
+static bool nextRecord(HistoryQuery& query) {
+  while (query.hour != HISTORY_END_OF_SEGMENTS) {
+    uint32_t second;
+    int32_t values[2];
+    if (query.decoder.remaining > 0 && seriesNext(query.decoder, &second, values)) {
+      query.record.second = second;
+      query.record.slot = query.slot;
+      query.record.temperature = values[0];
+      query.record.humidity = values[1];
+      query.recordTime = recordTime(query.hour, second);
+      return true;
+    }
+    query.decoder.remaining = 0;
+
+    if (query.file) {
+      if (nextBlock(query)) continue;
+      query.file.close();
+    }
+
+    uint8_t index = firstSegmentFrom(query.hour ? query.hour + 1 : query.from / 3600);
+    if (index == segmentCount || segmentHours[index] > query.lastHour ||
+        segmentHours[index] * 3600 >= query.to) {
+      query.hour = HISTORY_END_OF_SEGMENTS;
+      break;
+    }
+
+    char path[32];
+    query.hour = segmentHours[index];
+    segmentPath(path, sizeof(path), query.hour);
+    query.file = LittleFS.open(path, "r");
+    if (!query.file) continue;  // Removed by retention meanwhile
+
+    query.fileEnd = query.file.size();
+    if (query.hour == query.lastHour) {
+      query.fileEnd = min(query.fileEnd, query.lastSize);
+    }
+  }
+
+  if (query.pendingRead < query.pendingCount) {
+    query.record = query.pending[query.pendingRead++];
+    query.recordTime = recordTime(query.pendingHour, query.record.second);
+    return true;
+  }
+  return false;
+}
+
+// Aggregate the next bucket into "[t,avg,min,max]", 0 when no data is left
+static int nextPoint(HistoryQuery& query, char* out, size_t size) {
+  uint32_t bucket = 0;
+  int32_t sum = 0;
+  int32_t low = 0;
+  int32_t high = 0;
+  uint16_t count = 0;
+
+  while (query.lookahead || nextRecord(query)) {
+    const HistoryRecord& record = query.record;
+    query.lookahead = true;
+
+    if (record.slot != query.slot || query.recordTime < query.from) {
+      query.lookahead = false;
+      continue;
+    }
+    if (query.recordTime >= query.to) {
+      // Records are in time order: nothing else in range
+      query.hour = HISTORY_END_OF_SEGMENTS;
+      query.file.close();
+      query.pendingRead = query.pendingCount;
+      query.lookahead = false;
+      break;
+    }
+
+    uint32_t start = query.from + (query.recordTime - query.from) / query.step * query.step;
+    if (count > 0 && start != bucket) {
+      break;  // Record starts the next bucket, kept for the next call
+    }
+
+    int32_t value = query.humidity ? (int32_t)record.humidity : (int32_t)record.temperature;
+    if (count == 0 || value < low) low = value;
+    if (count == 0 || value > high) high = value;
+    bucket = start;
+    sum += value;
+    count++;
+    query.lookahead = false;
+  }
+
+  if (count == 0) {
+    return 0;
+  }
+
+  int32_t average = (sum + (sum < 0 ? -(int32_t)count : count) / 2) / (int32_t)count;
+  char avg[12], lo[12], hi[12];
+  formatFixed(avg, sizeof(avg), average, 100);
+  formatFixed(lo, sizeof(lo), low, 100);
+  formatFixed(hi, sizeof(hi), high, 100);
+  return snprintf(out, size, "%s[%lu,%s,%s,%s]", query.firstPoint ? "" : ",",
+                  (unsigned long)bucket, avg, lo, hi);
+}
+
+size_t readHistoryJson(HistoryQuery& query, char* buffer, size_t size) {
+  size_t used = 0;
+
+  if (query.part == HISTORY_PART_HEADER) {
+    int n = snprintf(buffer, size, "{\"from\":%lu,\"to\":%lu,\"step\":%lu,\"unit\":\"%s\",\"points\":[",
+                     (unsigned long)query.from, (unsigned long)query.to, (unsigned long)query.step,
+                     query.humidity ? "%" : "C");
+    if (n < 0 || (size_t)n >= size) {
+      return 0;  // Try again with more room
+    }
+    used = n;
+    query.part = HISTORY_PART_POINTS;
+  }
+
+  while (query.part == HISTORY_PART_POINTS && size - used > HISTORY_POINT_MAX_LEN) {
+    int n = nextPoint(query, buffer + used, size - used);
+    if (n == 0) {
+      query.part = HISTORY_PART_FOOTER;
+      break;
+    }
+    used += n;
+    query.firstPoint = false;
+  }
+
+  if (query.part == HISTORY_PART_FOOTER && size - used > 2) {
+    buffer[used++] = ']';
+    buffer[used++] = '}';
+    query.part = HISTORY_PART_DONE;
+    query.file.close();
+  }
+
+  return used;
+}
+
+bool historyQueryDone(const HistoryQuery& query) {
+  return query.part == HISTORY_PART_DONE;
+}
@@ -0,0 +1,100 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "config.h"
+#include "series.h"
+
+// On-flash sample history (LittleFS), for /api/history without internet.
+// One file ("segment") per UTC hour: /history/<epoch hour>.bin, made of
+// blocks. A block holds the samples of one sensor, bit-packed with the
+// series encoder (series.h: delta-of-delta time, delta fixed-point values,
+// about 1-2 bytes per sample instead of 8), behind a small header with
+// its first/last second.
+// A range query finds its first segment in the in-RAM segment table (one
+// entry per hour) and then skips whole blocks by their headers, so it only
+// decodes blocks of the requested sensor and time range: the segment table
+// and the block headers are the sparse time index.
+// Samples are collected in RAM and appended every HISTORY_FLUSH_INTERVAL
+// (or at the hour change) to keep flash writes low. The oldest segments are
+// deleted when the history outgrows its budget, which always leaves room
+// for the OTA backup image.
+// Only samples taken with a valid clock (SNTP) are stored.
+
+#define HISTORY_DIR "/history"
+#define HISTORY_MAX_SEGMENTS 192        // 8 days of hourly segments
+#define HISTORY_MAX_BYTES 1048576       // Budget cap (blocks used by segments)
+#define HISTORY_FS_RESERVE 65536        // Filesystem space kept free besides the OTA backup
+#define HISTORY_PENDING_RECORDS 80      // RAM buffer (4 sensors x 10 min at 30 s)
+#define HISTORY_FLUSH_INTERVAL 600000   // ms
+#define HISTORY_MAX_POINTS 360          // Per query, step is raised to fit
+#define HISTORY_MAX_RANGE 2678400       // s (31 days)
+#define HISTORY_BLOCK_MAX 512           // Encoded bytes per block
+
+// One sample of one sensor (RAM, before encoding / after decoding)
+struct HistoryRecord {
+  uint16_t second;         // Since the start of the segment's hour
+  uint8_t slot;            // Sensor slot
+  uint8_t reserved;
+  int16_t temperature;     // centi-°C
+  uint16_t humidity;       // centi-%RH
+};
+
+// Block on flash: header, then length bytes of series data
+// (2 channels: temperature, humidity; time = second within the hour)
+struct HistoryBlockHeader {
+  uint16_t length;
+  uint16_t first_second;
+  uint16_t last_second;
+  uint8_t slot;
+  uint8_t count;           // Samples
+};
+
+// Range query state, kept between calls of readHistoryJson()
+struct HistoryQuery {
+  uint8_t slot;
+  bool humidity;
+  uint32_t from;           // Epoch s, inclusive
+  uint32_t to;             // Epoch s, exclusive
+  uint32_t step;           // Bucket length, s
+
+  // Cursor (internal)
+  uint8_t part;
+  uint32_t hour;           // Segment being read
+  uint32_t lastHour;       // Newest segment when the query started...
+  uint32_t lastSize;       // ...and its size then (later appends are in pending)
+  File file;
+  uint32_t fileEnd;
+  SeriesDecoder decoder;   // Block being decoded
+  uint8_t block[HISTORY_BLOCK_MAX];
+  HistoryRecord pending[HISTORY_PENDING_RECORDS];  // Unflushed records at start
+  uint32_t pendingHour;
+  uint8_t pendingCount;
+  uint8_t pendingRead;
+  bool lookahead;          // record/recordTime hold the next record
+  HistoryRecord record;
+  uint32_t recordTime;
+  bool firstPoint;
+};
+
+// Mount the filesystem and build the segment table (call once in setup)
+void initializeHistory();
+
+// Buffer the latest samples, flush when due (after every readSensors())
+void storeHistory();
+
+// Start a query for sensor name (as in rules: "*_humidity" = humidity).
+// from/to/step 0 = last 24 h / automatic. Returns false if the sensor is
+// unknown or the clock is not synced.
+bool beginHistoryQuery(HistoryQuery& query, const char* sensor,
+                       uint32_t from, uint32_t to, uint32_t step);
+
+// Next part of the JSON response, at most size bytes:
+// {"from","to","step","unit","points":[[bucket start, avg, min, max], ...]}
+// Returns 0 when complete or when size is too small for the next part
+// (see historyQueryDone)
+size_t readHistoryJson(HistoryQuery& query, char* buffer, size_t size);
+bool historyQueryDone(const HistoryQuery& query);
+
+#endif
@@ -0,0 +1,182 @@
+#include "metrics.h"
+#include "config.h"
+#include "sensors.h"
+#include "transport.h"
+#include "timesync.h"
+#include <ESP8266WiFi.h>
+
+static const uint16_t latencyBucketsMs[RPC_LATENCY_BUCKETS] = {100, 250, 500, 1000, 2500, 5000, 10000};
+static const char* const latencyBucketLabels[RPC_LATENCY_BUCKETS] = {"0.1", "0.25", "0.5", "1", "2.5", "5", "10"};
+
+struct RpcMetrics {
+  const char* rpc;
+  const char* endpoint;      // Label value
+  uint32_t ok;
+  uint32_t errors;
+  uint32_t durationMsSum;
+  uint32_t buckets[RPC_LATENCY_BUCKETS];  // Not cumulative, summed on output
+};
+
+static RpcMetrics rpcMetrics[] = {
+  {RPC_HEARTBEAT, "heartbeat", 0, 0, 0, {0}},
+  {RPC_INSERT_READINGS, "readings", 0, 0, 0, {0}},
+  {RPC_ACK_COMMANDS, "ack", 0, 0, 0, {0}},
+  {RPC_GET_CONFIG, "config", 0, 0, 0, {0}},
+  {RPC_GET_CONTROL_CONFIG, "control_config", 0, 0, 0, {0}},
+};
+
+#define RPC_METRICS_COUNT (sizeof(rpcMetrics) / sizeof(rpcMetrics[0]))
+
+static uint32_t loopCount = 0;
+static uint64_t loopUsSum = 0;
+static uint32_t loopUsMax = 0;
+
+void recordLoopTime(uint32_t durationUs) {
+  loopCount++;
+  loopUsSum += durationUs;
+  if (durationUs > loopUsMax) {
+    loopUsMax = durationUs;
+  }
+}
+
+void recordRpc(const char* rpc, bool ok, uint32_t durationMs) {
+  for (size_t i = 0; i < RPC_METRICS_COUNT; i++) {
+    RpcMetrics& metrics = rpcMetrics[i];
+    if (strcmp(metrics.rpc, rpc) != 0) continue;
+
+    if (ok) {
+      metrics.ok++;
+    } else {
+      metrics.errors++;
+    }
+    metrics.durationMsSum += durationMs;
+    for (uint8_t b = 0; b < RPC_LATENCY_BUCKETS; b++) {
+      if (durationMs <= latencyBucketsMs[b]) {
+        metrics.buckets[b]++;
+        break;
+      }
+    }
+    return;
+  }
+}
+
+// Label value: backslash, quote and newline escaped
+static void writeLabel(SnapshotWriter& out, const char* value) {
+  for (const char* c = value; *c; c++) {
+    if (*c == '\\' || *c == '"') {
+      out.write('\\');
+      out.write(*c);
+    } else if (*c == '\n') {
+      out.print("\\n");
+    } else {
+      out.write(*c);
+    }
+  }
+}
+
+static void writeHeader(SnapshotWriter& out, const char* name, const char* type, const char* help) {
+  out.printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+// Metric name and sensor labels, the caller appends the value
+static void writeSensorLabels(SnapshotWriter& out, const char* name, int slot) {
+  out.printf("%s{slot=\"%d\",name=\"", name, slot + 1);
+  writeLabel(out, deviceConfig.sensors[slot].name);
+  out.print("\"} ");
+}
+
+// Fixed-point sample value and end of line
+static void writeFixed(SnapshotWriter& out, int32_t value, uint16_t scale) {
+  char text[12];
+  formatFixed(text, sizeof(text), value, scale);
+  out.print(text);
+  out.print('\n');
+}
+
+// Seconds from an integer count of units (1000: ms, 1000000: us)
+static void writeSeconds(SnapshotWriter& out, uint64_t value, uint32_t perSecond, int decimals) {
+  out.printf("%llu.%0*llu\n", (unsigned long long)(value / perSecond), decimals,
+             (unsigned long long)(value % perSecond));
+}
+
+void writeMetrics(SnapshotWriter& out) {
+  writeHeader(out, "greenhouse_info", "gauge", "Device and firmware");
+  out.print("greenhouse_info{device_id=\"");
+  writeLabel(out, deviceConfig.composite_device_id);
+  out.printf("\",firmware=\"%s\"} 1\n", FIRMWARE_VERSION);
+
+  writeHeader(out, "greenhouse_config_version", "gauge", "Applied cloud config version");
+  out.printf("greenhouse_config_version %d\n", deviceConfig.config_version);
+
+  writeHeader(out, "greenhouse_uptime_seconds", "counter", "Time since boot");
+  out.printf("greenhouse_uptime_seconds %llu\n", (unsigned long long)(uptimeMs() / 1000));
+
+  writeHeader(out, "greenhouse_time_synced", "gauge", "SNTP clock valid");
+  out.printf("greenhouse_time_synced %d\n", timeSynced() ? 1 : 0);
+
+  // Memory
+  writeHeader(out, "greenhouse_heap_free_bytes", "gauge", "Free heap");
+  out.printf("greenhouse_heap_free_bytes %u\n", ESP.getFreeHeap());
+  writeHeader(out, "greenhouse_heap_max_block_bytes", "gauge", "Largest free heap block");
+  out.printf("greenhouse_heap_max_block_bytes %u\n", ESP.getMaxFreeBlockSize());
+  writeHeader(out, "greenhouse_heap_fragmentation_percent", "gauge", "Heap fragmentation");
+  out.printf("greenhouse_heap_fragmentation_percent %u\n", ESP.getHeapFragmentation());
+
+  // WiFi
+  writeHeader(out, "greenhouse_wifi_rssi_dbm", "gauge", "WiFi signal strength");
+  out.printf("greenhouse_wifi_rssi_dbm %d\n", WiFi.RSSI());
+
+  // Main loop
+  writeHeader(out, "greenhouse_loop_duration_seconds", "summary", "Duration of one main loop pass");
+  out.print("greenhouse_loop_duration_seconds_sum ");
+  writeSeconds(out, loopUsSum, 1000000, 6);
+  out.printf("greenhouse_loop_duration_seconds_count %u\n", loopCount);
+  writeHeader(out, "greenhouse_loop_duration_max_seconds", "gauge", "Longest main loop pass since boot");
+  out.print("greenhouse_loop_duration_max_seconds ");
+  writeSeconds(out, loopUsMax, 1000000, 6);
+
+  // Sensors (values only while the last read succeeded)
+  writeHeader(out, "greenhouse_temperature_celsius", "gauge", "Latest temperature");
+  for (int i = 0; i < MAX_SENSORS; i++) {
+    if (deviceConfig.sensors[i].type == 0 || !sensorReadings[i].valid) continue;
+    writeSensorLabels(out, "greenhouse_temperature_celsius", i);
+    writeFixed(out, sensorReadings[i].temperature, SCALE_TEMPERATURE);
+  }
+  writeHeader(out, "greenhouse_humidity_percent", "gauge", "Latest relative humidity");
+  for (int i = 0; i < MAX_SENSORS; i++) {
+    if (deviceConfig.sensors[i].type == 0 || !sensorReadings[i].valid) continue;
+    writeSensorLabels(out, "greenhouse_humidity_percent", i);
+    writeFixed(out, sensorReadings[i].humidity, SCALE_HUMIDITY);
+  }
+  writeHeader(out, "greenhouse_sensor_read_failures_total", "counter", "Failed sensor reads since the sensor config was applied");
+  for (int i = 0; i < MAX_SENSORS; i++) {
+    if (deviceConfig.sensors[i].type == 0) continue;
+    writeSensorLabels(out, "greenhouse_sensor_read_failures_total", i);
+    out.printf("%u\n", sensorReadings[i].failures);
+  }
+
+  // Backend calls
+  writeHeader(out, "greenhouse_rpc_requests_total", "counter", "Backend calls by endpoint and result");
+  for (size_t i = 0; i < RPC_METRICS_COUNT; i++) {
+    const RpcMetrics& metrics = rpcMetrics[i];
+    out.printf("greenhouse_rpc_requests_total{endpoint=\"%s\",result=\"ok\"} %u\n", metrics.endpoint, metrics.ok);
+    out.printf("greenhouse_rpc_requests_total{endpoint=\"%s\",result=\"error\"} %u\n", metrics.endpoint, metrics.errors);
+  }
+
+  writeHeader(out, "greenhouse_rpc_duration_seconds", "histogram", "Backend call latency by endpoint");
+  for (size_t i = 0; i < RPC_METRICS_COUNT; i++) {
+    const RpcMetrics& metrics = rpcMetrics[i];
+    uint32_t cumulative = 0;
+    for (uint8_t b = 0; b < RPC_LATENCY_BUCKETS; b++) {
+      cumulative += metrics.buckets[b];
+      out.printf("greenhouse_rpc_duration_seconds_bucket{endpoint=\"%s\",le=\"%s\"} %u\n",
+                 metrics.endpoint, latencyBucketLabels[b], cumulative);
+    }
+    out.printf("greenhouse_rpc_duration_seconds_bucket{endpoint=\"%s\",le=\"+Inf\"} %u\n",
+               metrics.endpoint, metrics.ok + metrics.errors);
+    out.printf("greenhouse_rpc_duration_seconds_sum{endpoint=\"%s\"} ", metrics.endpoint);
+    writeSeconds(out, metrics.durationMsSum, 1000, 3);
+    out.printf("greenhouse_rpc_duration_seconds_count{endpoint=\"%s\"} %u\n",
+               metrics.endpoint, metrics.ok + metrics.errors);
+  }
+}
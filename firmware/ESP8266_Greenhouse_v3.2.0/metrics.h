@@ -0,0 +1,22 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include "snapshot.h"
+
+// Runtime counters for the Prometheus /metrics endpoint (LAN scraping).
+// Everything is kept in fixed static tables; the exposition text is
+// written into the /metrics snapshot buffer, without String.
+
+#define RPC_LATENCY_BUCKETS 7  // 0.1 0.25 0.5 1 2.5 5 10 s (+Inf implicit)
+
+// Duration of one loop() pass
+void recordLoopTime(uint32_t durationUs);
+
+// Result and duration of one backend call (transportCall)
+void recordRpc(const char* rpc, bool ok, uint32_t durationMs);
+
+// Prometheus text format 0.0.4
+void writeMetrics(SnapshotWriter& out);
+
+#endif
@@ -0,0 +1,939 @@
+#include "ota.h"
+#include "realtime.h"
+#include <ESP8266WiFi.h>
+#include <ESP8266HTTPClient.h>
+#include <ESP8266mDNS.h>
+#include <WiFiClientSecure.h>
+#include <ArduinoJson.h>
+#include <Updater.h>
+#include <LittleFS.h>
+#include <bearssl/bearssl_hash.h>
+
+#define OTA_CHUNK_SIZE 4096          // Flash write buffer = one flash sector
+#define OTA_READ_SIZE 1460           // Network read buffer = one TCP segment
+#define OTA_MAX_RESUMES 5            // Range requests after a dropped connection
+#define OTA_STALL_TIMEOUT 15000      // No data for 15s = connection dropped
+#define OTA_RESUME_DELAY 2000
+#define OTA_PROGRESS_STEP 25         // Report every 25%
+#define OTA_STEP_BYTES 8192          // Max artifact bytes consumed per otaStep()
+
+#define OTA_MAX_PEERS 5              // LAN peers probed for a matching image
+#define OTA_DISCOVERY_WAIT 1000      // mDNS answers collected before probing
+#define OTA_PEER_TIMEOUT 500         // One peer probed per otaStep()
+#define OTA_HASH_STEP 16384          // Running image bytes hashed per loop pass
+
+#define OTA_MAX_BOOT_ATTEMPTS 3      // Boots without confirmation before rollback
+#define OTA_CONFIRM_UPTIME 180000    // Local health: up this long, sampling and looping
+
+// 1 = also require a successful heartbeat before confirming a new image
+// (a backend outage then rolls back a working image after the boot limit)
+#ifndef OTA_CONFIRM_BACKEND
+#define OTA_CONFIRM_BACKEND 0
+#endif
+#define OTA_BACKUP_PATH "/ota/previous.bin"
+#define OTA_BACKUP_MARGIN 16384      // Keep some filesystem space free
+
+// Delta patch format (little endian), produced by tools/ota_artifacts.py:
+//   "SDP1" <u32 target_size>
+//   'C' <u32 offset> <u32 length>   copy bytes from the running image
+//   'I' <u32 length> <data>         insert literal bytes
+#define PATCH_MAGIC "SDP1"
+#define PATCH_HEADER_SIZE 8
+#define PATCH_OP_COPY 'C'
+#define PATCH_OP_INSERT 'I'
+
+enum OtaSegmentResult {
+  OTA_SEGMENT_STREAMING,  // Connected, more data to read
+  OTA_SEGMENT_DONE,       // Whole artifact received
+  OTA_SEGMENT_RETRY,      // Connection dropped, resume with Range
+  OTA_SEGMENT_FAILED      // Permanent error
+};
+
+// Artifact sources, tried in this order
+enum OtaSource {
+  OTA_SOURCE_LAN,      // Peer device running the same image
+  OTA_SOURCE_DELTA,    // Binary delta against the running image
+  OTA_SOURCE_FULL,     // Full (or gzip) image from the cloud
+  OTA_SOURCE_COUNT
+};
+
+enum OtaPhase {
+  OTA_PHASE_IDLE,
+  OTA_PHASE_DISCOVER,     // Looking for a LAN peer with the image
+  OTA_PHASE_CONNECT,
+  OTA_PHASE_STREAM,
+  OTA_PHASE_RETRY_WAIT
+};
+
+enum PatchState {
+  PATCH_HEADER,
+  PATCH_OP,
+  PATCH_INSERT
+};
+
+struct OtaState {
+  const DeviceCommand* cmd;
+  bool delta;                // Applying a delta patch instead of a full image
+  const char* kind;          // "full", "delta" or "lan" (download metrics)
+  const char* url;           // Artifact being downloaded
+  const char* expectedSha;   // SHA-256 of the image written to flash
+
+  // Download side (artifact bytes)
+  uint32_t downloadTotal;
+  uint32_t received;
+  int lastReported;
+
+  // Flash side (image bytes)
+  br_sha256_context sha;
+  uint8_t* outBuffer;
+  size_t outFill;
+  uint32_t imageSize;
+  uint32_t written;
+
+  // Delta patch parser
+  PatchState patchState;
+  uint8_t patchArgs[PATCH_HEADER_SIZE + 1];
+  uint8_t patchNeed;
+  uint8_t patchHave;
+  uint32_t insertRemaining;
+
+  // Job progress
+  OtaPhase phase;
+  int source;                // OtaSource being downloaded
+  int attempt;               // Resumes of the current artifact
+  unsigned long phaseStart;  // Last data received / retry wait start
+  unsigned long startTime;   // Artifact download start (metrics)
+  uint8_t* readBuffer;
+  WiFiClient* client;
+  HTTPClient* http;
+
+  // LAN discovery
+  MDNSResponder::hMDNSServiceQuery peerQuery;
+  uint8_t peer;              // Next mDNS answer to probe
+  char lanUrl[48];
+};
+
+static OtaState otaJob;  // Update in progress (one at a time)
+
+static char otaError[32] = "";
+
+static void setOtaError(const char* message) {
+  strncpy(otaError, message, sizeof(otaError) - 1);
+  otaError[sizeof(otaError) - 1] = '\0';
+  Serial.printf("OTA error: %s\n", message);
+}
+
+const char* otaLastError() {
+  return otaError;
+}
+
+static uint32_t readLE32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Compare computed digest with hex string from command payload
+static bool sha256Matches(const uint8_t* digest, const char* expectedHex) {
+  const char hexChars[] = "0123456789abcdef";
+  for (int i = 0; i < 32; i++) {
+    if (tolower(expectedHex[i * 2]) != hexChars[digest[i] >> 4] ||
+        tolower(expectedHex[i * 2 + 1]) != hexChars[digest[i] & 0x0F]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Hash and write the buffered flash chunk. The chunk completing the image is
+// only written after the digest matches, so a bad image is never committed.
+static bool flushOutput(OtaState& st) {
+  if (st.outFill == 0) {
+    return true;
+  }
+
+  br_sha256_update(&st.sha, st.outBuffer, st.outFill);
+
+  if (st.written + st.outFill == st.imageSize) {
+    uint8_t digest[32];
+    br_sha256_out(&st.sha, digest);
+    if (!sha256Matches(digest, st.expectedSha)) {
+      setOtaError("SHA-256 mismatch");
+      return false;
+    }
+    Serial.println("OTA: SHA-256 verified");
+  }
+
+  if (Update.write(st.outBuffer, st.outFill) != st.outFill) {
+    setOtaError(Update.getErrorString().c_str());
+    return false;
+  }
+
+  st.written += st.outFill;
+  st.outFill = 0;
+  return true;
+}
+
+// Append image bytes, flushing full sectors to flash
+static bool emitImage(OtaState& st, const uint8_t* data, size_t length) {
+  while (length > 0) {
+    if (st.written + st.outFill + length > st.imageSize) {
+      setOtaError("Image larger than announced");
+      return false;
+    }
+
+    size_t n = min(length, (size_t)OTA_CHUNK_SIZE - st.outFill);
+    memcpy(st.outBuffer + st.outFill, data, n);
+    st.outFill += n;
+    data += n;
+    length -= n;
+
+    if (st.outFill == OTA_CHUNK_SIZE || st.written + st.outFill == st.imageSize) {
+      if (!flushOutput(st)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Copy a range of the running image (flash offset 0) into the new image
+static bool emitFromRunningImage(OtaState& st, uint32_t offset, uint32_t length) {
+  if (offset + length > ESP.getSketchSize()) {
+    setOtaError("Patch copy out of range");
+    return false;
+  }
+
+  uint32_t words[64];
+  while (length > 0) {
+    uint32_t aligned = offset & ~3UL;
+    uint32_t skip = offset - aligned;
+    uint32_t n = min(length, (uint32_t)sizeof(words) - skip);
+    uint32_t readSize = (skip + n + 3) & ~3UL;
+
+    if (!ESP.flashRead(aligned, words, readSize)) {
+      setOtaError("Flash read failed");
+      return false;
+    }
+    if (!emitImage(st, (const uint8_t*)words + skip, n)) {
+      return false;
+    }
+
+    offset += n;
+    length -= n;
+  }
+  return true;
+}
+
+static bool beginImage(OtaState& st, uint32_t imageSize) {
+  st.imageSize = imageSize;
+  Serial.printf("OTA: image size %u bytes\n", imageSize);
+
+  if (!Update.begin(imageSize)) {
+    setOtaError(Update.getErrorString().c_str());
+    return false;
+  }
+  return true;
+}
+
+// Streaming delta patch interpreter
+static bool applyPatch(OtaState& st, const uint8_t* data, size_t length) {
+  while (length > 0) {
+    if (st.patchState == PATCH_INSERT) {
+      size_t n = min((uint32_t)length, st.insertRemaining);
+      if (!emitImage(st, data, n)) {
+        return false;
+      }
+      st.insertRemaining -= n;
+      data += n;
+      length -= n;
+      if (st.insertRemaining == 0) {
+        st.patchState = PATCH_OP;
+        st.patchNeed = 0;
+        st.patchHave = 0;
+      }
+      continue;
+    }
+
+    // Collect header / op arguments
+    st.patchArgs[st.patchHave++] = *data++;
+    length--;
+
+    if (st.patchState == PATCH_HEADER) {
+      if (st.patchHave < PATCH_HEADER_SIZE) {
+        continue;
+      }
+      if (memcmp(st.patchArgs, PATCH_MAGIC, 4) != 0) {
+        setOtaError("Invalid patch header");
+        return false;
+      }
+      if (!beginImage(st, readLE32(st.patchArgs + 4))) {
+        return false;
+      }
+      st.patchState = PATCH_OP;
+      st.patchNeed = 0;
+      st.patchHave = 0;
+      continue;
+    }
+
+    // PATCH_OP: first byte selects the argument length
+    if (st.patchHave == 1) {
+      if (st.patchArgs[0] == PATCH_OP_COPY) {
+        st.patchNeed = 9;
+      } else if (st.patchArgs[0] == PATCH_OP_INSERT) {
+        st.patchNeed = 5;
+      } else {
+        setOtaError("Invalid patch opcode");
+        return false;
+      }
+    }
+    if (st.patchHave < st.patchNeed) {
+      continue;
+    }
+
+    if (st.patchArgs[0] == PATCH_OP_COPY) {
+      if (!emitFromRunningImage(st, readLE32(st.patchArgs + 1), readLE32(st.patchArgs + 5))) {
+        return false;
+      }
+      st.patchHave = 0;
+    } else {
+      st.insertRemaining = readLE32(st.patchArgs + 1);
+      st.patchState = (st.insertRemaining > 0) ? PATCH_INSERT : PATCH_OP;
+      st.patchHave = 0;
+    }
+  }
+  return true;
+}
+
+// Feed downloaded artifact bytes into the image writer
+static bool consumeDownload(OtaState& st, const uint8_t* data, size_t length) {
+  bool ok = st.delta ? applyPatch(st, data, length) : emitImage(st, data, length);
+  if (!ok) {
+    return false;
+  }
+
+  st.received += length;
+
+  int percent = (int)((uint64_t)st.received * 100 / st.downloadTotal);
+  if (percent / OTA_PROGRESS_STEP > st.lastReported / OTA_PROGRESS_STEP && percent < 100) {
+    st.lastReported = percent;
+    Serial.printf("OTA: %d%% (%u/%u bytes)\n", percent, st.received, st.downloadTotal);
+    reportCommandProgress(st.cmd->id, percent);
+  }
+  return true;
+}
+
+// ========================================
+// LAN image sharing
+// ========================================
+
+static char runningSha[65] = "";
+static br_sha256_context runningShaContext;
+static uint32_t runningShaOffset = 0;
+
+void updateImageSha256() {
+  if (runningSha[0] != '\0' || !firmwareSharingEnabled()) {
+    return;
+  }
+
+  if (runningShaOffset == 0) {
+    br_sha256_init(&runningShaContext);
+  }
+
+  // OTA_HASH_STEP bytes per loop pass
+  uint32_t size = ESP.getSketchSize();
+  uint32_t words[256];
+  uint32_t end = min(runningShaOffset + OTA_HASH_STEP, size);
+  while (runningShaOffset < end) {
+    uint32_t n = min((uint32_t)sizeof(words), end - runningShaOffset);
+    if (!ESP.flashRead(runningShaOffset, words, (n + 3) & ~3UL)) {
+      Serial.println("OTA: cannot read running image, hash restarted");
+      runningShaOffset = 0;
+      return;
+    }
+    br_sha256_update(&runningShaContext, words, n);
+    runningShaOffset += n;
+  }
+  if (runningShaOffset < size) {
+    return;
+  }
+
+  uint8_t digest[32];
+  br_sha256_out(&runningShaContext, digest);
+  for (int i = 0; i < 32; i++) {
+    sprintf(runningSha + i * 2, "%02x", digest[i]);
+  }
+  Serial.printf("OTA: running image sha256 %s\n", runningSha);
+}
+
+const char* runningImageSha256() {
+  return runningSha[0] != '\0' ? runningSha : nullptr;
+}
+
+bool firmwareSharingEnabled() {
+  // An image that has not been confirmed healthy is not handed out
+  return !rtcState.ota_pending;
+}
+
+// Ask one peer for the hash of the image it shares
+static bool peerHasImage(IPAddress ip, uint16_t port, const char* sha256) {
+  char infoUrl[48];
+  snprintf(infoUrl, sizeof(infoUrl), "http://%s:%u/firmware/info", ip.toString().c_str(), port);
+
+  WiFiClient client;
+  HTTPClient http;
+  http.begin(client, infoUrl);
+  http.setTimeout(OTA_PEER_TIMEOUT);
+
+  bool match = false;
+  if (http.GET() == HTTP_CODE_OK) {
+    StaticJsonDocument<256> doc;
+    if (!deserializeJson(doc, http.getString())) {
+      const char* peerSha = doc["sha256"] | "";
+      match = strcasecmp(peerSha, sha256) == 0;
+    }
+  }
+  http.end();
+  return match;
+}
+
+static void stopDiscovery(OtaState& st) {
+  if (st.peerQuery) {
+    MDNS.removeServiceQuery(st.peerQuery);
+    st.peerQuery = nullptr;
+  }
+}
+
+// Peers advertising _serra-fw._tcp answer the query started by startSource()
+// in the background (MDNS.update() in loop). After OTA_DISCOVERY_WAIT, one
+// peer is asked per call. True while looking or once st.lanUrl is set
+// (phase CONNECT), false if no peer has the image.
+static bool discoverLanSource(OtaState& st) {
+  if (millis() - st.phaseStart < OTA_DISCOVERY_WAIT) {
+    return true;
+  }
+
+  uint32_t answers = MDNS.answerCount(st.peerQuery);
+  while (st.peer < answers && st.peer < OTA_MAX_PEERS) {
+    uint8_t i = st.peer++;
+    if (!MDNS.hasAnswerIP4Address(st.peerQuery, i)) {
+      continue;
+    }
+    IPAddress ip = MDNS.answerIP4Address(st.peerQuery, i, 0);
+    if (ip == WiFi.localIP()) {
+      continue;
+    }
+
+    uint16_t port = MDNS.answerPort(st.peerQuery, i);
+    if (!peerHasImage(ip, port, st.expectedSha)) {
+      return true;  // Next peer on the next step
+    }
+
+    snprintf(st.lanUrl, sizeof(st.lanUrl), "http://%s:%u/firmware.bin", ip.toString().c_str(), port);
+    Serial.printf("OTA: LAN source %s\n", st.lanUrl);
+    stopDiscovery(st);
+    st.phase = OTA_PHASE_CONNECT;
+    st.startTime = millis();
+    return true;
+  }
+
+  Serial.printf("OTA: no LAN peer with the image (%u sharing firmware)\n", answers);
+  stopDiscovery(st);
+  return false;
+}
+
+// ========================================
+// Download job (advanced by otaStep)
+// ========================================
+
+static void closeConnection(OtaState& st) {
+  if (st.http) {
+    st.http->end();
+    delete st.http;
+    st.http = nullptr;
+  }
+  if (st.client) {
+    delete st.client;
+    st.client = nullptr;
+  }
+  digitalWrite(LED_BUILTIN, HIGH);
+}
+
+static void releaseBuffers(OtaState& st) {
+  delete[] st.readBuffer;
+  delete[] st.outBuffer;
+  st.readBuffer = nullptr;
+  st.outBuffer = nullptr;
+  st.phase = OTA_PHASE_IDLE;
+}
+
+// Send the (range) request for the current artifact
+static OtaSegmentResult openSegment(OtaState& st) {
+  if (strncmp(st.url, "https://", 8) == 0) {
+    WiFiClientSecure* secure = new WiFiClientSecure();
+    secure->setInsecure();
+    st.client = secure;
+  } else {
+    st.client = new WiFiClient();
+  }
+  st.http = new HTTPClient();
+
+  HTTPClient& http = *st.http;
+  http.begin(*st.client, st.url);
+  http.setTimeout(OTA_STALL_TIMEOUT);
+  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+
+  if (st.received > 0) {
+    char range[32];
+    snprintf(range, sizeof(range), "bytes=%u-", st.received);
+    http.addHeader("Range", range);
+    Serial.printf("OTA: resuming at byte %u\n", st.received);
+  }
+
+  digitalWrite(LED_BUILTIN, LOW);
+  int httpCode = http.GET();
+
+  if (st.received == 0) {
+    if (httpCode != HTTP_CODE_OK) {
+      Serial.printf("OTA: download failed: %d\n", httpCode);
+      if (httpCode <= 0) {
+        return OTA_SEGMENT_RETRY;
+      }
+      char message[32];
+      snprintf(message, sizeof(message), "Download failed: HTTP %d", httpCode);
+      setOtaError(message);
+      return OTA_SEGMENT_FAILED;
+    }
+
+    int size = http.getSize();
+    if (size <= 0) {
+      setOtaError("Unknown download size");
+      return OTA_SEGMENT_FAILED;
+    }
+
+    st.downloadTotal = size;
+    Serial.printf("OTA: downloading %u bytes (%s)\n", st.downloadTotal, st.kind);
+
+    // Full image: flash size is the download size (gzip images are
+    // written as-is and expanded by the bootloader)
+    if (!st.delta && !beginImage(st, st.downloadTotal)) {
+      return OTA_SEGMENT_FAILED;
+    }
+  } else if (httpCode != HTTP_CODE_PARTIAL_CONTENT) {
+    // Server ignored Range: data would not line up with what is in flash
+    Serial.printf("OTA: resume rejected: %d\n", httpCode);
+    if (httpCode <= 0) {
+      return OTA_SEGMENT_RETRY;
+    }
+    setOtaError("Server does not support resume");
+    return OTA_SEGMENT_FAILED;
+  }
+
+  st.phaseStart = millis();
+  return OTA_SEGMENT_STREAMING;
+}
+
+// Consume what the connection has buffered, at most OTA_STEP_BYTES
+static OtaSegmentResult readSegment(OtaState& st) {
+  WiFiClient* stream = st.http->getStreamPtr();
+  size_t consumed = 0;
+
+  while (st.received < st.downloadTotal && consumed < OTA_STEP_BYTES) {
+    size_t available = stream->available();
+
+    if (available == 0) {
+      if (!st.http->connected() || millis() - st.phaseStart > OTA_STALL_TIMEOUT) {
+        return OTA_SEGMENT_RETRY;
+      }
+      return OTA_SEGMENT_STREAMING;  // Nothing buffered yet, back next step
+    }
+
+    size_t wanted = min(available, (size_t)OTA_READ_SIZE);
+    wanted = min(wanted, (size_t)(st.downloadTotal - st.received));
+    size_t n = stream->readBytes(st.readBuffer, wanted);
+    st.phaseStart = millis();
+
+    if (!consumeDownload(st, st.readBuffer, n)) {
+      return OTA_SEGMENT_FAILED;
+    }
+    consumed += n;
+  }
+
+  return (st.received == st.downloadTotal) ? OTA_SEGMENT_DONE : OTA_SEGMENT_STREAMING;
+}
+
+// Prepare download of the artifact for st.source, false if not applicable
+static bool startSource(OtaState& st) {
+  const DeviceCommand& cmd = *st.cmd;
+
+  switch (st.source) {
+    case OTA_SOURCE_LAN:
+      // A device on the same LAN already running this exact image saves the
+      // uplink; st.lanUrl is set by discoverLanSource(). Peers report and
+      // serve the raw image: matched and verified by its digest, not by
+      // sha256 (the gzip artifact for compressed rollouts).
+      if (strlen(cmd.image_sha256) != 64) {
+        return false;
+      }
+      st.peerQuery = MDNS.installServiceQuery("serra-fw", "tcp", nullptr);
+      if (!st.peerQuery) {
+        return false;
+      }
+      st.peer = 0;
+      st.delta = false;
+      st.kind = "lan";
+      st.url = st.lanUrl;
+      st.expectedSha = cmd.image_sha256;
+      break;
+
+    case OTA_SOURCE_DELTA:
+      // Delta patch only applies to the exact image it was built against
+      if (strlen(cmd.delta_url) == 0 || strlen(cmd.delta_sha256) != 64) {
+        return false;
+      }
+      if (!ESP.getSketchMD5().equalsIgnoreCase(cmd.delta_base_md5)) {
+        Serial.println("OTA: running image does not match delta base, using full image");
+        return false;
+      }
+      st.delta = true;
+      st.kind = "delta";
+      st.url = cmd.delta_url;
+      st.expectedSha = cmd.delta_sha256;
+      break;
+
+    case OTA_SOURCE_FULL:
+      st.delta = false;
+      st.kind = "full";
+      st.url = cmd.url;
+      st.expectedSha = cmd.sha256;
+      break;
+
+    default:
+      return false;
+  }
+
+  st.downloadTotal = 0;
+  st.received = 0;
+  st.lastReported = 0;
+  st.outFill = 0;
+  st.imageSize = 0;
+  st.written = 0;
+  st.patchState = PATCH_HEADER;
+  st.patchNeed = PATCH_HEADER_SIZE;
+  st.patchHave = 0;
+  st.insertRemaining = 0;
+  br_sha256_init(&st.sha);
+
+  st.attempt = 0;
+  st.phase = st.source == OTA_SOURCE_LAN ? OTA_PHASE_DISCOVER : OTA_PHASE_CONNECT;
+  st.phaseStart = millis();
+  st.startTime = millis();
+  return true;
+}
+
+// Move on to the next applicable source, false when all were tried
+static bool nextSource(OtaState& st) {
+  while (++st.source < OTA_SOURCE_COUNT) {
+    if (startSource(st)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Whole artifact received: check the image and report download metrics
+static bool finishDownload(OtaState& st) {
+  uint32_t elapsed = millis() - st.startTime;
+  Serial.printf("OTA: %s download %u bytes in %u ms\n", st.kind, st.received, elapsed);
+
+  if (st.written != st.imageSize) {
+    setOtaError("Image shorter than announced");
+    return false;
+  }
+
+  reportCommandMetrics(st.cmd->id, st.received, elapsed, st.kind);
+  return true;
+}
+
+static bool backupRunningImage(uint8_t* buffer);
+
+// Verified image is complete: commit it for the bootloader
+static bool commitImage(OtaState& st) {
+  // Keep the running image so a new image that fails to boot can be reverted
+  if (!backupRunningImage(st.outBuffer)) {
+    Serial.println("OTA: no backup of running image, rollback will not be possible");
+  }
+
+  releaseBuffers(st);
+
+  if (!Update.end()) {
+    setOtaError(Update.getErrorString().c_str());
+    setupRealtime();
+    return false;
+  }
+
+  // New image boots unconfirmed until it has run healthy (checkOtaHealth)
+  packUuid(st.cmd->id, rtcState.ota_command_id);
+  strncpy(rtcState.ota_version, st.cmd->version, sizeof(rtcState.ota_version) - 1);
+  rtcState.ota_version[sizeof(rtcState.ota_version) - 1] = '\0';
+  rtcState.ota_pending = 1;
+  rtcState.boot_attempts = 0;
+  saveRtcState();
+
+  Serial.println("OTA Update successful!");
+  return true;
+}
+
+bool otaBegin(const DeviceCommand& cmd) {
+  Serial.println("\n--- OTA Firmware Update ---");
+  Serial.printf("Firmware URL: %s\n", cmd.url);
+  Serial.printf("Target version: %s\n", cmd.version);
+
+  otaError[0] = '\0';
+
+  if (strlen(cmd.sha256) != 64) {
+    setOtaError("Missing or invalid sha256");
+    return false;
+  }
+
+  // Free the push channel TLS session, the download needs the heap
+  stopRealtime();
+
+  OtaState& st = otaJob;
+  st.cmd = &cmd;
+  st.outBuffer = new uint8_t[OTA_CHUNK_SIZE];
+  st.readBuffer = new uint8_t[OTA_READ_SIZE];
+  st.client = nullptr;
+  st.http = nullptr;
+  st.peerQuery = nullptr;
+
+  Serial.println("Starting OTA update in background...");
+
+  // Cloud URL is always applicable (parseCommand rejects an empty url)
+  st.source = OTA_SOURCE_LAN;
+  if (!startSource(st)) {
+    nextSource(st);
+  }
+  return true;
+}
+
+OtaStepResult otaStep() {
+  OtaState& st = otaJob;
+  OtaSegmentResult result;
+
+  switch (st.phase) {
+    case OTA_PHASE_DISCOVER:
+      if (discoverLanSource(st) || nextSource(st)) {
+        return OTA_STEP_RUNNING;
+      }
+      releaseBuffers(st);
+      setupRealtime();
+      return OTA_STEP_FAILED;
+
+    case OTA_PHASE_CONNECT:
+      if (st.attempt > 0) {
+        Serial.printf("OTA: connection lost, retry %d/%d\n", st.attempt, OTA_MAX_RESUMES);
+      }
+      result = openSegment(st);
+      break;
+
+    case OTA_PHASE_STREAM:
+      result = readSegment(st);
+      break;
+
+    case OTA_PHASE_RETRY_WAIT:
+      if (millis() - st.phaseStart >= OTA_RESUME_DELAY) {
+        st.phase = OTA_PHASE_CONNECT;
+      }
+      return OTA_STEP_RUNNING;
+
+    default:
+      return OTA_STEP_FAILED;
+  }
+
+  if (result == OTA_SEGMENT_STREAMING) {
+    st.phase = OTA_PHASE_STREAM;
+    return OTA_STEP_RUNNING;
+  }
+
+  closeConnection(st);
+
+  if (result == OTA_SEGMENT_RETRY) {
+    if (++st.attempt <= OTA_MAX_RESUMES) {
+      st.phase = OTA_PHASE_RETRY_WAIT;
+      st.phaseStart = millis();
+      return OTA_STEP_RUNNING;
+    }
+    setOtaError("Download interrupted");
+    result = OTA_SEGMENT_FAILED;
+  }
+
+  if (result == OTA_SEGMENT_DONE && finishDownload(st)) {
+    return commitImage(st) ? OTA_STEP_DONE : OTA_STEP_FAILED;
+  }
+
+  // Incomplete image: discarded, boot partition untouched
+  if (Update.isRunning()) {
+    Update.end();
+  }
+
+  Serial.printf("OTA: %s download failed (%s)\n", st.kind, otaError);
+  if (nextSource(st)) {
+    return OTA_STEP_RUNNING;
+  }
+
+  releaseBuffers(st);
+  setupRealtime();
+  return OTA_STEP_FAILED;
+}
+
+void otaAbort() {
+  OtaState& st = otaJob;
+  if (st.phase == OTA_PHASE_IDLE) {
+    return;
+  }
+
+  Serial.println("OTA: update aborted");
+  stopDiscovery(st);
+  closeConnection(st);
+  if (Update.isRunning()) {
+    Update.end();
+  }
+  releaseBuffers(st);
+  setupRealtime();
+}
+
+// ========================================
+// Boot confirmation and rollback
+// ========================================
+
+// Copy running image (flash offset 0) to the filesystem
+static bool backupRunningImage(uint8_t* buffer) {
+  if (!LittleFS.begin()) {
+    return false;
+  }
+
+  uint32_t size = ESP.getSketchSize();
+  FSInfo info;
+  LittleFS.info(info);
+  LittleFS.remove(OTA_BACKUP_PATH);
+  if (info.totalBytes - info.usedBytes < size + OTA_BACKUP_MARGIN) {
+    Serial.printf("OTA: not enough filesystem space for backup (%u bytes)\n", size);
+    return false;
+  }
+
+  File f = LittleFS.open(OTA_BACKUP_PATH, "w");
+  if (!f) {
+    return false;
+  }
+
+  Serial.printf("OTA: backing up running image (%u bytes)...\n", size);
+  uint32_t offset = 0;
+  while (offset < size) {
+    uint32_t n = min((uint32_t)OTA_CHUNK_SIZE, size - offset);
+    if (!ESP.flashRead(offset, (uint32_t*)buffer, (n + 3) & ~3UL) || f.write(buffer, n) != n) {
+      f.close();
+      LittleFS.remove(OTA_BACKUP_PATH);
+      return false;
+    }
+    offset += n;
+    yield();
+  }
+
+  f.close();
+  return true;
+}
+
+// Stage the backed up image, bootloader copies it on next restart
+static bool restorePreviousImage() {
+  if (!LittleFS.begin()) {
+    return false;
+  }
+
+  File f = LittleFS.open(OTA_BACKUP_PATH, "r");
+  if (!f) {
+    return false;
+  }
+
+  uint8_t* buffer = new uint8_t[OTA_CHUNK_SIZE];
+  bool ok = Update.begin(f.size());
+
+  while (ok && f.available()) {
+    size_t n = f.read(buffer, OTA_CHUNK_SIZE);
+    ok = (Update.write(buffer, n) == n);
+    yield();
+  }
+
+  delete[] buffer;
+  f.close();
+
+  if (!ok || !Update.end()) {
+    Serial.printf("OTA: restore failed: %s\n", Update.getErrorString().c_str());
+    return false;
+  }
+  return true;
+}
+
+void checkOtaBoot() {
+  if (!rtcState.ota_pending) {
+    return;
+  }
+
+  rtcState.boot_attempts++;
+  saveRtcState();
+  Serial.printf("OTA: unconfirmed image, boot attempt %d/%d\n",
+                rtcState.boot_attempts, OTA_MAX_BOOT_ATTEMPTS);
+
+  if (rtcState.boot_attempts <= OTA_MAX_BOOT_ATTEMPTS) {
+    return;
+  }
+
+  Serial.println("OTA: new image failed to boot, restoring previous image...");
+  if (!restorePreviousImage()) {
+    Serial.println("OTA: no previous image available, keeping current image");
+    return;
+  }
+
+  // Ack is delivered by the restored firmware
+  char commandId[37];
+  unpackUuid(rtcState.ota_command_id, commandId);
+  rtcState.ota_pending = 0;
+  rtcState.boot_attempts = 0;
+  acknowledgeCommand(commandId, false, "Boot failed, rolled back");
+  LittleFS.remove(OTA_BACKUP_PATH);
+
+  Serial.println("OTA: rollback staged, restarting...");
+  delay(100);
+  ESP.restart();
+}
+
+static bool backendReached = false;
+
+void otaBackendReached() {
+  backendReached = true;
+}
+
+void checkOtaHealth(bool sensorsSampled) {
+  if (!rtcState.ota_pending || !sensorsSampled || millis() < OTA_CONFIRM_UPTIME) {
+    return;
+  }
+  if (OTA_CONFIRM_BACKEND && !backendReached) {
+    return;
+  }
+
+  char commandId[37];
+  unpackUuid(rtcState.ota_command_id, commandId);
+
+  // Same version as before = bootloader did not apply the new image
+  bool applied = strlen(rtcState.ota_version) == 0 ||
+                 strcmp(rtcState.ota_version, FIRMWARE_VERSION) == 0;
+
+  rtcState.ota_pending = 0;
+  rtcState.boot_attempts = 0;
+  acknowledgeCommand(commandId, applied, applied ? nullptr : "Image not applied");
+
+  Serial.printf("OTA: firmware %s confirmed %s after %lu s\n", FIRMWARE_VERSION,
+                applied ? "healthy" : "but version does not match", millis() / 1000);
+
+  if (LittleFS.begin()) {
+    LittleFS.remove(OTA_BACKUP_PATH);
+  }
+}
@@ -0,0 +1,51 @@
+#ifndef OTA_H
+#define OTA_H
+
+#include <Arduino.h>
+#include "commands.h"
+
+enum OtaStepResult {
+  OTA_STEP_RUNNING,
+  OTA_STEP_DONE,      // New image committed, caller restarts
+  OTA_STEP_FAILED     // See otaLastError()
+};
+
+// Streaming OTA update: writes the image into the spare flash partition,
+// verifies its SHA-256 before committing and resumes dropped downloads
+// with HTTP Range requests. Progress is reported on the command ack channel.
+// cmd must stay valid until the update ends.
+bool otaBegin(const DeviceCommand& cmd);
+
+// Advance the running update by a bounded amount of work (call from loop)
+OtaStepResult otaStep();
+
+// Cancel the running update, the partial image is discarded
+void otaAbort();
+
+// Reason of last failure (for command ack)
+const char* otaLastError();
+
+// Call early in setup(): counts boots of an unconfirmed image and restores
+// the previous image after OTA_MAX_BOOT_ATTEMPTS boots without confirmation
+void checkOtaBoot();
+
+// Hash the running image for LAN sharing, a slice per call (call every
+// loop; flash reads are too slow for the async web server context)
+void updateImageSha256();
+
+// SHA-256 (hex) of the running image, nullptr until updateImageSha256()
+// has finished
+const char* runningImageSha256();
+
+// Running image may be served to peers (not an unconfirmed OTA image)
+bool firmwareSharingEnabled();
+
+// Call after each successful heartbeat (only needed with OTA_CONFIRM_BACKEND)
+void otaBackendReached();
+
+// Call at the end of every loop pass. Marks a freshly installed image
+// healthy once it has run OTA_CONFIRM_UPTIME with sensors sampled, without
+// needing the backend, and acknowledges the pending firmware_update command
+void checkOtaHealth(bool sensorsSampled);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Push channel for commands (Supabase Realtime broadcast over WebSocket).
+// A new row in device_commands broadcasts only its id on topic
+// "device:<composite_device_id>": the channel is public, so the payload
+// (wifi_update credentials...) is fetched with the next heartbeat, which
+// the notification brings forward. The heartbeat keeps polling as
+// fallback when the channel is down.
+// Local stand-in for testing: firmware/tools/realtime_standin.py
+
+void setupRealtime();
+void stopRealtime();
+void handleRealtime();
+bool isRealtimeConnected();
+
+// A command was announced and the last heartbeat is at least
+// REALTIME_MIN_POLL_INTERVAL old: send one now (clears the notification)
+bool realtimePollDue(unsigned long sinceHeartbeat);
+
+#endif
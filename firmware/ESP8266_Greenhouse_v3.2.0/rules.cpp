@@ -0,0 +1,332 @@
+#include "rules.h"
+#include "sensors.h"
+#include "actuators.h"
+#include "timesync.h"
+#include <time.h>
+
+#define RULE_STALE_READING 90000    // Same limit as control loops
+
+static_assert(MAX_RULES <= 8, "Pending rules are tracked in an 8 bit mask");
+
+// Runtime state per rule (not persisted)
+struct RuleState {
+  bool active;             // Rule currently drives its actuator
+  bool lastCondition;      // For rising edge detection (pulses)
+  unsigned long pulseStart;
+};
+
+static RuleState ruleState[MAX_RULES];
+static uint8_t pendingRules = 0;   // Bit i = rule i waits for evaluation
+static uint8_t nextRule = 0;       // Round-robin start when the budget runs out
+
+// ========================================
+// Compiler (config sync only)
+// ========================================
+
+struct RuleToken {
+  const char* token;
+  uint8_t op;
+  uint8_t pops;
+};
+
+static const RuleToken ruleTokens[] = {
+  {"hour", RULE_OP_HOUR, 0},
+  {"minute", RULE_OP_MINUTE, 0},
+  {"<", RULE_OP_LT, 2},
+  {"<=", RULE_OP_LE, 2},
+  {">", RULE_OP_GT, 2},
+  {">=", RULE_OP_GE, 2},
+  {"==", RULE_OP_EQ, 2},
+  {"!=", RULE_OP_NE, 2},
+  {"and", RULE_OP_AND, 2},
+  {"or", RULE_OP_OR, 2},
+  {"not", RULE_OP_NOT, 1},
+  {"+", RULE_OP_ADD, 2},
+  {"-", RULE_OP_SUB, 2},
+};
+
+static bool emit(uint8_t byte) {
+  if (ruleProgram.code_length >= MAX_RULE_CODE) {
+    return false;
+  }
+  ruleProgram.code[ruleProgram.code_length++] = byte;
+  return true;
+}
+
+// Returns nullptr on success, otherwise the reason the rule was rejected
+static const char* compileTokens(JsonArrayConst tokens, uint8_t* instructions) {
+  int depth = 0;
+  *instructions = 0;
+
+  for (JsonVariantConst token : tokens) {
+    uint8_t pops = 0;
+
+    if (token.is<float>()) {
+      float value = token.as<float>();
+      uint8_t bytes[sizeof(float)];
+      memcpy(bytes, &value, sizeof(float));
+      if (!emit(RULE_OP_CONST)) return "program too large";
+      for (uint8_t b : bytes) {
+        if (!emit(b)) return "program too large";
+      }
+    } else if (token.is<const char*>()) {
+      const char* name = token.as<const char*>();
+      const RuleToken* match = nullptr;
+
+      for (const RuleToken& entry : ruleTokens) {
+        if (strcmp(entry.token, name) == 0) {
+          match = &entry;
+          break;
+        }
+      }
+
+      uint8_t index;
+      bool humidity;
+      if (match) {
+        if (!emit(match->op)) return "program too large";
+        pops = match->pops;
+      } else if (strncmp(name, "output:", 7) == 0) {
+        index = findActuator(name + 7);
+        if (index == ACTUATOR_INVALID) return "unknown actuator";
+        if (!emit(RULE_OP_OUTPUT) || !emit(index)) return "program too large";
+      } else if (findSensor(name, &index, &humidity)) {
+        if (!emit(humidity ? RULE_OP_HUMIDITY : RULE_OP_TEMPERATURE) || !emit(index)) {
+          return "program too large";
+        }
+      } else {
+        return "unknown token";
+      }
+    } else {
+      return "invalid token";
+    }
+
+    // Stack depth is fixed per position, so it is checked once here
+    if (depth < pops) return "stack underflow";
+    depth = depth - pops + 1;
+    if (depth > RULE_STACK_DEPTH) return "stack too deep";
+    if (++(*instructions) > RULE_BUDGET_PER_TICK) return "too many instructions";
+  }
+
+  return depth == 1 ? nullptr : "expression must leave one value";
+}
+
+bool compileRule(JsonArrayConst tokens, uint8_t actuatorIndex, uint8_t value,
+                 uint16_t durationSeconds) {
+  if (ruleProgram.rule_count >= MAX_RULES) {
+    Serial.println("Max rules reached, ignoring remaining rules");
+    return false;
+  }
+
+  uint8_t start = ruleProgram.code_length;
+  uint8_t instructions;
+  const char* error = compileTokens(tokens, &instructions);
+
+  if (error) {
+    Serial.printf("  Rule %d: %s, skipping\n", ruleProgram.rule_count, error);
+    ruleProgram.code_length = start;
+    return false;
+  }
+
+  RuleConfig& rule = ruleProgram.rules[ruleProgram.rule_count];
+  rule.actuator_index = actuatorIndex;
+  rule.value = min(value, (uint8_t)100);
+  rule.duration_s = durationSeconds;
+  rule.code_offset = start;
+  rule.code_length = ruleProgram.code_length - start;
+  rule.instructions = instructions;
+
+  Serial.printf("  Rule %d: %s, %d instruction(s), %d bytes\n",
+                ruleProgram.rule_count, controlConfig.actuators[actuatorIndex].actuator_id,
+                instructions, rule.code_length);
+
+  ruleProgram.rule_count++;
+  return true;
+}
+
+// ========================================
+// Evaluator
+// ========================================
+
+// Returns false when the condition cannot be evaluated
+static bool evaluateRule(const RuleConfig& rule, bool* result) {
+  float stack[RULE_STACK_DEPTH];
+  int top = 0;
+  const uint8_t* code = ruleProgram.code + rule.code_offset;
+  const uint8_t* end = code + rule.code_length;
+  unsigned long now = millis();
+  struct tm local;
+  bool haveClock = false;
+
+  while (code < end) {
+    uint8_t op = *code++;
+    float a, b;
+
+    // The compiler checked the depth, this only guards a corrupt program
+    if ((op < RULE_OP_LT && top >= RULE_STACK_DEPTH) ||
+        (op >= RULE_OP_LT && top < (op == RULE_OP_NOT ? 1 : 2))) {
+      return false;
+    }
+
+    switch (op) {
+      case RULE_OP_CONST:
+        memcpy(&stack[top++], code, sizeof(float));
+        code += sizeof(float);
+        break;
+
+      case RULE_OP_TEMPERATURE:
+      case RULE_OP_HUMIDITY: {
+        const SensorReading& reading = sensorReadings[*code++ % MAX_SENSORS];
+        if (reading.readAt == 0 || now - reading.readAt > RULE_STALE_READING) {
+          return false;
+        }
+        stack[top++] = op == RULE_OP_HUMIDITY ? fromFixed(reading.humidity, SCALE_HUMIDITY)
+                                              : fromFixed(reading.temperature, SCALE_TEMPERATURE);
+        break;
+      }
+
+      case RULE_OP_OUTPUT:
+        stack[top++] = actuatorOutput(*code++);
+        break;
+
+      case RULE_OP_HOUR:
+      case RULE_OP_MINUTE:
+        if (!haveClock) {
+          if (!timeSynced()) {
+            return false;
+          }
+          time_t epoch = time(nullptr);
+          localtime_r(&epoch, &local);
+          haveClock = true;
+        }
+        stack[top++] = op == RULE_OP_HOUR ? local.tm_hour : local.tm_min;
+        break;
+
+      case RULE_OP_NOT:
+        stack[top - 1] = stack[top - 1] == 0 ? 1 : 0;
+        break;
+
+      default:
+        // Binary operators (operand count checked by the compiler)
+        b = stack[--top];
+        a = stack[top - 1];
+        switch (op) {
+          case RULE_OP_LT:  a = a < b; break;
+          case RULE_OP_LE:  a = a <= b; break;
+          case RULE_OP_GT:  a = a > b; break;
+          case RULE_OP_GE:  a = a >= b; break;
+          case RULE_OP_EQ:  a = a == b; break;
+          case RULE_OP_NE:  a = a != b; break;
+          case RULE_OP_AND: a = (a != 0) && (b != 0); break;
+          case RULE_OP_OR:  a = (a != 0) || (b != 0); break;
+          case RULE_OP_ADD: a = a + b; break;
+          case RULE_OP_SUB: a = a - b; break;
+          default: return false;  // Corrupt program
+        }
+        stack[top - 1] = a;
+        break;
+    }
+  }
+
+  *result = top == 1 && stack[0] != 0;
+  return top == 1;
+}
+
+static void applyRule(uint8_t index) {
+  const RuleConfig& rule = ruleProgram.rules[index];
+  RuleState& state = ruleState[index];
+  const char* actuatorId = controlConfig.actuators[rule.actuator_index].actuator_id;
+
+  // Manual command in effect: start from scratch once the hold expires
+  if (actuatorManualHold(rule.actuator_index)) {
+    state.active = false;
+    state.lastCondition = false;
+    return;
+  }
+
+  bool condition = false;
+  if (!evaluateRule(rule, &condition)) {
+    condition = false;  // Missing input: fail safe
+  }
+
+  bool rising = condition && !state.lastCondition;
+  state.lastCondition = condition;
+
+  if (rule.duration_s > 0) {
+    if (rising && !state.active) {
+      Serial.printf("Rule %d: %s %d%% for %u s\n", index, actuatorId, rule.value, rule.duration_s);
+      state.active = true;
+      state.pulseStart = millis();
+      setActuator(rule.actuator_index, rule.value, rule.duration_s * 1000UL);
+    }
+  } else if (condition != state.active) {
+    Serial.printf("Rule %d: %s %d%%\n", index, actuatorId, condition ? rule.value : 0);
+    state.active = condition;
+    setActuator(rule.actuator_index, condition ? rule.value : 0);
+  }
+}
+
+void initializeRules() {
+  memset(ruleState, 0, sizeof(ruleState));
+  pendingRules = 0;
+  nextRule = 0;
+
+  // Drop rules whose actuator disappeared from the table
+  for (uint8_t i = 0; i < ruleProgram.rule_count; i++) {
+    if (ruleProgram.rules[i].actuator_index >= controlConfig.actuator_count ||
+        ruleProgram.rules[i].code_offset + ruleProgram.rules[i].code_length > ruleProgram.code_length) {
+      Serial.println("Rule program does not match actuators, disabled");
+      ruleProgram.rule_count = 0;
+      break;
+    }
+  }
+
+  Serial.printf("Rules: %d active\n", ruleProgram.rule_count);
+}
+
+void triggerRules() {
+  pendingRules = (1 << ruleProgram.rule_count) - 1;
+}
+
+void runRules() {
+  unsigned long now = millis();
+
+  // Pulses end on time, not on the next sample
+  for (uint8_t i = 0; i < ruleProgram.rule_count; i++) {
+    const RuleConfig& rule = ruleProgram.rules[i];
+    RuleState& state = ruleState[i];
+
+    if (state.active && rule.duration_s > 0 && now - state.pulseStart >= rule.duration_s * 1000UL) {
+      Serial.printf("Rule %d: pulse done, %s off\n", i, controlConfig.actuators[rule.actuator_index].actuator_id);
+      state.active = false;
+      if (!actuatorManualHold(rule.actuator_index)) {
+        setActuator(rule.actuator_index, 0);
+      }
+    }
+  }
+
+  int budget = RULE_BUDGET_PER_TICK;
+  while (pendingRules != 0) {
+    uint8_t index = nextRule;
+    while (!(pendingRules & (1 << index))) {
+      index = (index + 1) % ruleProgram.rule_count;
+    }
+
+    // Rule does not fit in what is left: continue on the next tick
+    if (ruleProgram.rules[index].instructions > budget) {
+      nextRule = index;
+      break;
+    }
+
+    budget -= ruleProgram.rules[index].instructions;
+    pendingRules &= ~(1 << index);
+    nextRule = (index + 1) % ruleProgram.rule_count;
+    applyRule(index);
+  }
+}
+
+bool ruleActive(int ruleIndex) {
+  if (ruleIndex < 0 || ruleIndex >= ruleProgram.rule_count) {
+    return false;
+  }
+  return ruleState[ruleIndex].active;
+}
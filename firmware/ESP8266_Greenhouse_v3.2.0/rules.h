@@ -0,0 +1,63 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// On-device automation rules, e.g. "soil < 30 and hour 6-8 -> pump on 90 s".
+// The cloud sends each condition as a flattened expression (postfix token
+// array). It is compiled once per config sync into bytecode for a small
+// stack machine, with sensor and actuator names resolved to indices.
+// Every new sample marks all rules pending; runRules() evaluates them from
+// loop() with a fixed instruction budget per call, so a long program never
+// stalls the loop (the rest continues on the next tick).
+//
+// Tokens: numbers, sensor names (deviceConfig.sensors[].name or the derived
+// *_humidity name), "output:<actuator_id>" (current output %), "hour",
+// "minute" (local time, TIME_ZONE), "< <= > >= == !=", "and or not", "+ -".
+// Conditions that cannot be evaluated (stale sensor, no SNTP sync yet) count as
+// false: the rule's actuator is switched off, like a control loop without input.
+
+// Bytecode instruction set (operands follow the opcode byte)
+enum RuleOp {
+  RULE_OP_CONST = 1,      // float (4 bytes, little endian)
+  RULE_OP_TEMPERATURE,    // sensor index
+  RULE_OP_HUMIDITY,       // sensor index
+  RULE_OP_OUTPUT,         // actuator index
+  RULE_OP_HOUR,
+  RULE_OP_MINUTE,
+  RULE_OP_LT,
+  RULE_OP_LE,
+  RULE_OP_GT,
+  RULE_OP_GE,
+  RULE_OP_EQ,
+  RULE_OP_NE,
+  RULE_OP_AND,
+  RULE_OP_OR,
+  RULE_OP_NOT,
+  RULE_OP_ADD,
+  RULE_OP_SUB
+};
+
+#define RULE_STACK_DEPTH 8
+#define RULE_BUDGET_PER_TICK 64  // Instructions per runRules() call (also max per rule)
+
+// Compile one rule condition and append it to ruleProgram
+// (controlConfig and deviceConfig.sensors must already be applied)
+bool compileRule(JsonArrayConst tokens, uint8_t actuatorIndex, uint8_t value,
+                 uint16_t durationSeconds);
+
+// Reset rule state (after config changes, call initializeActuators first)
+void initializeRules();
+
+// New sample available: evaluate every rule again
+void triggerRules();
+
+// Evaluate pending rules within the budget, end expired pulses (every loop)
+void runRules();
+
+// Rule i currently driving its actuator
+bool ruleActive(int ruleIndex);
+
+#endif
@@ -0,0 +1,71 @@
+#include "sample.h"
+
+uint16_t sampleScale(uint8_t sensorType, bool humidity) {
+  switch (sensorType) {
+    case 1:   // DHT22
+    case 2:   // DHT11
+      return humidity ? SCALE_HUMIDITY : SCALE_TEMPERATURE;
+    case 3:   // Soil moisture
+      return SCALE_SOIL;
+    default:
+      return 1;
+  }
+}
+
+int32_t toFixed(float value, uint16_t scale) {
+  return lroundf(value * scale);
+}
+
+float fromFixed(int32_t value, uint16_t scale) {
+  return (float)value / scale;
+}
+
+// Rounded n / d (d > 0)
+static int32_t divideRounded(int64_t n, int32_t d) {
+  return (int32_t)((n >= 0 ? n + d / 2 : n - d / 2) / d);
+}
+
+int32_t calibrateSample(const SensorCalibration& calibration, int32_t raw) {
+  if (calibration.mode == CALIBRATION_LINEAR) {
+    return divideRounded((int64_t)raw * calibration.gain, 1000) + calibration.offset;
+  }
+
+  if (calibration.mode == CALIBRATION_TABLE && calibration.point_count >= 2 &&
+      calibration.point_count <= MAX_CALIBRATION_POINTS) {
+    uint8_t i = 1;
+    while (i < calibration.point_count - 1 && raw > calibration.raw[i]) {
+      i++;
+    }
+
+    int32_t raw0 = calibration.raw[i - 1];
+    int32_t value0 = calibration.value[i - 1];
+    int32_t span = calibration.raw[i] - raw0;
+    if (span <= 0) {
+      return raw;  // Not ascending (rejected when parsed)
+    }
+    return value0 + divideRounded((int64_t)(raw - raw0) * (calibration.value[i] - value0), span);
+  }
+
+  return raw;
+}
+
+int formatFixed(char* out, size_t size, int32_t value, uint16_t scale) {
+  if (scale <= 1) {
+    return snprintf(out, size, "%ld", (long)value);
+  }
+
+  int decimals = 0;
+  for (uint16_t s = scale; s > 1; s /= 10) {
+    decimals++;
+  }
+
+  uint32_t magnitude = value < 0 ? 0 - (uint32_t)value : (uint32_t)value;
+  return snprintf(out, size, "%s%lu.%0*lu", value < 0 ? "-" : "",
+                  (unsigned long)(magnitude / scale), decimals, (unsigned long)(magnitude % scale));
+}
+
+void setFixed(JsonObject object, const char* key, int32_t value, uint16_t scale) {
+  char text[16];
+  formatFixed(text, sizeof(text), value, scale);
+  object[key] = serialized(text);  // char*: copied, unlike const char*
+}
@@ -0,0 +1,36 @@
+#ifndef SAMPLE_H
+#define SAMPLE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// Fixed-point sample values.
+// Readings are scaled integers from the sensor driver on; floats only
+// appear at the edges (DHT library, PID and rule arithmetic). Formatting
+// for JSON and logs is integer only: float printf is soft-float on the
+// ESP8266 and costs far more than the sample itself.
+
+#define SCALE_TEMPERATURE 100   // centi-°C
+#define SCALE_HUMIDITY 10       // deci-%RH
+#define SCALE_SOIL 10           // permille (deci-%)
+
+// Scale of a sensor type's value (humidity: second DHT channel)
+uint16_t sampleScale(uint8_t sensorType, bool humidity);
+
+// Driver value to fixed point (rounded) and back
+int32_t toFixed(float value, uint16_t scale);
+float fromFixed(int32_t value, uint16_t scale);
+
+// Corrected value of a raw fixed-point value (integer arithmetic only;
+// tables extrapolate from their first / last segment)
+int32_t calibrateSample(const SensorCalibration& calibration, int32_t raw);
+
+// Decimal text with all decimals of scale ("21.35" for 2135 / 100),
+// snprintf() return value
+int formatFixed(char* out, size_t size, int32_t value, uint16_t scale);
+
+// JSON number from a fixed-point value (text copied into the document)
+void setFixed(JsonObject object, const char* key, int32_t value, uint16_t scale);
+
+#endif
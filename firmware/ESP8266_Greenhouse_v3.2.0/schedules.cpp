@@ -0,0 +1,210 @@
+#include "schedules.h"
+#include "actuators.h"
+#include "timesync.h"
+#include <Ticker.h>
+#include <time.h>
+
+#define SCHEDULE_ARM_MS 2000  // Hand over to the timer this close to a start
+
+// Runtime state per entry (not persisted)
+struct ScheduleState {
+  bool running;
+  uint64_t nextStartMs;     // Epoch ms of the next start (0 = not planned)
+  uint64_t stopAtMs;        // Epoch ms when the running window ends
+};
+
+static ScheduleState scheduleState[MAX_SCHEDULES];
+static bool planned = false;         // Missed runs handled, next starts known
+static bool lastRunDirty = false;    // last_run changed, save from loop()
+static Ticker startTicker;
+
+static uint64_t nowEpochMs() {
+  return epochMsAt(millis());
+}
+
+// Start of entry on the day reference + dayOffset (local time), 0 if that
+// weekday is not selected. mktime() handles DST changes.
+static time_t startOnDay(const ScheduleEntry& entry, time_t reference, int dayOffset) {
+  struct tm local;
+  localtime_r(&reference, &local);
+
+  local.tm_mday += dayOffset;
+  local.tm_hour = entry.start_s / 3600;
+  local.tm_min = (entry.start_s / 60) % 60;
+  local.tm_sec = entry.start_s % 60;
+  local.tm_isdst = -1;
+
+  time_t start = mktime(&local);
+  return (entry.weekdays & (1 << local.tm_wday)) ? start : 0;
+}
+
+static time_t nextStartAfter(const ScheduleEntry& entry, time_t now) {
+  for (int day = 0; day <= 7; day++) {
+    time_t start = startOnDay(entry, now, day);
+    if (start > now) return start;
+  }
+  return 0;
+}
+
+static time_t lastStartBefore(const ScheduleEntry& entry, time_t now) {
+  for (int day = 0; day >= -7; day--) {
+    time_t start = startOnDay(entry, now, day);
+    if (start != 0 && start <= now) return start;
+  }
+  return 0;
+}
+
+static void startEntry(uint8_t index, uint64_t nowMs, uint32_t durationMs) {
+  ScheduleEntry& entry = scheduleTable.entries[index];
+  ScheduleState& state = scheduleState[index];
+
+  if (actuatorManualHold(entry.actuator_index)) {
+    Serial.printf("Schedule %d: %s under manual control, skipped\n",
+                  index, controlConfig.actuators[entry.actuator_index].actuator_id);
+    return;
+  }
+
+  state.running = true;
+  state.stopAtMs = nowMs + durationMs;
+  entry.last_run = nowMs / 1000;
+  lastRunDirty = true;
+  setActuator(entry.actuator_index, entry.value, durationMs);
+}
+
+static void planNext(uint8_t index, uint64_t nowMs) {
+  time_t next = nextStartAfter(scheduleTable.entries[index], nowMs / 1000);
+  scheduleState[index].nextStartMs = (uint64_t)next * 1000;
+}
+
+// Start every entry that is due (from loop() or the start timer)
+static void startDueEntries() {
+  uint64_t nowMs = nowEpochMs();
+
+  for (uint8_t i = 0; i < scheduleTable.count; i++) {
+    ScheduleState& state = scheduleState[i];
+    if (state.nextStartMs == 0 || nowMs < state.nextStartMs) continue;
+
+    const ScheduleEntry& entry = scheduleTable.entries[i];
+    Serial.printf("Schedule %d: %s %d%% for %u s (%d ms late)\n",
+                  i, controlConfig.actuators[entry.actuator_index].actuator_id,
+                  entry.value, entry.duration_s, (int)(nowMs - state.nextStartMs));
+
+    startEntry(i, state.nextStartMs, entry.duration_s * 1000UL);
+    planNext(i, nowMs);
+  }
+}
+
+// First valid clock after boot or config change: missed runs, then plan
+static void planSchedules(uint64_t nowMs) {
+  time_t now = nowMs / 1000;
+
+  for (uint8_t i = 0; i < scheduleTable.count; i++) {
+    ScheduleEntry& entry = scheduleTable.entries[i];
+
+    // No history (config applied before the clock was valid): nothing was
+    // missed, starts count from now
+    if (entry.last_run == 0) {
+      entry.last_run = now;
+      lastRunDirty = true;
+      planNext(i, nowMs);
+      continue;
+    }
+
+    time_t last = lastStartBefore(entry, now);
+    if (last != 0 && entry.missed_policy != MISSED_SKIP && entry.last_run < (uint32_t)last) {
+      uint64_t windowEndMs = ((uint64_t)last + entry.duration_s) * 1000;
+
+      if (nowMs < windowEndMs) {
+        Serial.printf("Schedule %d: resuming missed run, %u s left\n",
+                      i, (unsigned)((windowEndMs - nowMs) / 1000));
+        startEntry(i, nowMs, windowEndMs - nowMs);
+      } else if (entry.missed_policy == MISSED_CATCH_UP && now - last < SCHEDULE_CATCH_UP_WINDOW) {
+        Serial.printf("Schedule %d: catching up run missed %u min ago\n",
+                      i, (unsigned)((now - last) / 60));
+        startEntry(i, nowMs, entry.duration_s * 1000UL);
+      }
+    }
+
+    planNext(i, nowMs);
+  }
+
+  planned = true;
+}
+
+void initializeSchedules() {
+  startTicker.detach();
+  memset(scheduleState, 0, sizeof(scheduleState));
+  planned = false;
+
+  // Drop entries whose actuator disappeared from the table
+  for (uint8_t i = 0; i < scheduleTable.count; i++) {
+    if (scheduleTable.entries[i].actuator_index >= controlConfig.actuator_count) {
+      Serial.println("Schedule table does not match actuators, disabled");
+      scheduleTable.count = 0;
+      break;
+    }
+  }
+
+  Serial.printf("Schedules: %d active\n", scheduleTable.count);
+}
+
+void runSchedules() {
+  if (scheduleTable.count == 0 || !timeSynced()) {
+    return;
+  }
+
+  uint64_t nowMs = nowEpochMs();
+
+  if (!planned) {
+    planSchedules(nowMs);
+  }
+
+  // Windows end from the loop (start accuracy matters more than the stop)
+  for (uint8_t i = 0; i < scheduleTable.count; i++) {
+    ScheduleState& state = scheduleState[i];
+    if (!state.running || nowMs < state.stopAtMs) continue;
+
+    const ScheduleEntry& entry = scheduleTable.entries[i];
+    state.running = false;
+    Serial.printf("Schedule %d: done, %s off\n", i, controlConfig.actuators[entry.actuator_index].actuator_id);
+    if (!actuatorManualHold(entry.actuator_index)) {
+      setActuator(entry.actuator_index, 0);
+    }
+  }
+
+  // Late (loop was blocked and the timer was not armed yet) or exactly due
+  startDueEntries();
+
+  // Arm the one-shot timer for the next start
+  if (!startTicker.active()) {
+    uint64_t nextMs = 0;
+    for (uint8_t i = 0; i < scheduleTable.count; i++) {
+      uint64_t start = scheduleState[i].nextStartMs;
+      if (start != 0 && (nextMs == 0 || start < nextMs)) nextMs = start;
+    }
+
+    if (nextMs != 0 && nextMs - nowMs <= SCHEDULE_ARM_MS) {
+      startTicker.once_ms((uint32_t)(nextMs - nowMs), startDueEntries);
+    }
+  }
+
+  // Flash write only from the loop, not from the timer callback
+  if (lastRunDirty) {
+    lastRunDirty = false;
+    saveSchedules();
+  }
+}
+
+bool scheduleRunning(int index) {
+  if (index < 0 || index >= scheduleTable.count) {
+    return false;
+  }
+  return scheduleState[index].running;
+}
+
+uint32_t scheduleNextStart(int index) {
+  if (index < 0 || index >= scheduleTable.count) {
+    return 0;
+  }
+  return scheduleState[index].nextStartMs / 1000;
+}
@@ -0,0 +1,30 @@
+#ifndef SCHEDULES_H
+#define SCHEDULES_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// On-device timers (irrigation): start an actuator at a local time of day
+// on selected weekdays, for a fixed duration. The table comes from cloud
+// config and is kept in EEPROM, so timers also run without WiFi once the
+// clock has been synced (SNTP) after boot.
+// runSchedules() plans from the main loop; the last stretch before a start
+// is covered by a one-shot timer, so a start is not delayed by a blocking
+// HTTP call in loop(). When the clock first becomes valid, runs missed while
+// the device was off are handled per entry (MissedRunPolicy).
+
+#define SCHEDULE_CATCH_UP_WINDOW 21600  // s: MISSED_CATCH_UP only for starts < 6 h ago
+
+// Reset timer state (after config changes, call initializeActuators first)
+void initializeSchedules();
+
+// Start / stop due timers (every loop)
+void runSchedules();
+
+// Entry i currently running
+bool scheduleRunning(int index);
+
+// Epoch seconds of the next start of entry i (0 = clock not synced)
+uint32_t scheduleNextStart(int index);
+
+#endif
@@ -3,13 +3,45 @@
 
 #include <DHT.h>
 #include "config.h"
+#include "sample.h"
 
 #define MAX_DHT_SENSORS 4
+#define READING_HISTORY_SIZE 24  // Recent samples kept in RAM (local API)
+
+// Latest local reading per sensor slot (also used by local control)
+struct SensorReading {
+  int16_t temperature;     // centi-°C (SCALE_TEMPERATURE)
+  uint16_t humidity;       // deci-%RH (SCALE_HUMIDITY)
+  bool valid;              // Last read succeeded
+  unsigned long readAt;    // millis() of last successful read
+  uint32_t failures;       // Failed reads (metrics)
+};
+
+// One entry of the in-RAM history ring
+struct ReadingSample {
+  uint32_t readAt;         // millis() of the sample
+  int16_t temperature;     // centi-°C
+  uint16_t humidity;       // deci-%RH
+  uint8_t slot;            // Sensor slot
+};
 
 extern DHT* dhtSensors[MAX_DHT_SENSORS];
+extern SensorReading sensorReadings[MAX_SENSORS];
+extern uint32_t sensorDataVersion;  // Incremented on every new sample
+
+// History ring, index 0 = oldest
+uint8_t readingHistoryCount();
+const ReadingSample& readingHistoryAt(uint8_t index);
+
+// Sensor slot by name (rules, history); "*_humidity" also matches the
+// "*_temp" DHT slot
+bool findSensor(const char* name, uint8_t* index, bool* humidity);
+
+// Cloud sensor_type of a slot's humidity value ("x_temp" -> "x_humidity")
+String humiditySensorType(uint8_t slot);
 
 void initializeSensors();
-void readAndSendSensorData();
-bool sendSensorReadings();
+void readSensors();          // Local sampling, works without WiFi
+bool sendSensorReadings();   // Upload latest readings
 
 #endif
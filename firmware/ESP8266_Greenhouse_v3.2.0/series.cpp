@@ -0,0 +1,159 @@
+#include "series.h"
+
+static const uint8_t bucketBits[] = {0, 4, 8, 12, 32};
+
+// ========================================
+// Encoder
+// ========================================
+
+static bool writeBits(SeriesEncoder& encoder, uint32_t value, uint8_t count) {
+  if (encoder.bits + count > encoder.capacity * 8) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < count; i++, encoder.bits++) {
+    uint8_t mask = 1 << (encoder.bits % 8);
+    if (value & (1UL << i)) {
+      encoder.data[encoder.bits / 8] |= mask;
+    } else {
+      encoder.data[encoder.bits / 8] &= ~mask;
+    }
+  }
+  return true;
+}
+
+static bool writeDelta(SeriesEncoder& encoder, int32_t delta) {
+  uint32_t zigzag = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+
+  uint8_t bucket = 0;
+  while (bucket < 4 && (bucket == 0 ? zigzag != 0 : zigzag >= (1UL << bucketBits[bucket]))) {
+    bucket++;
+  }
+
+  // Prefix: bucket ones, then a zero (none after the last bucket)
+  for (uint8_t i = 0; i < bucket; i++) {
+    if (!writeBits(encoder, 1, 1)) return false;
+  }
+  if (bucket < 4 && !writeBits(encoder, 0, 1)) {
+    return false;
+  }
+  return writeBits(encoder, zigzag, bucketBits[bucket]);
+}
+
+void seriesBegin(SeriesEncoder& encoder, uint8_t* buffer, size_t capacity, uint8_t channels) {
+  encoder.data = buffer;
+  encoder.capacity = capacity;
+  encoder.bits = 0;
+  encoder.channels = min(channels, (uint8_t)SERIES_MAX_CHANNELS);
+  encoder.count = 0;
+  encoder.lastTime = 0;
+  encoder.lastDelta = 0;
+  memset(encoder.last, 0, sizeof(encoder.last));
+}
+
+bool seriesAppend(SeriesEncoder& encoder, uint32_t time, const int32_t* values) {
+  size_t start = encoder.bits;
+  int32_t delta = time - encoder.lastTime;
+
+  bool ok = encoder.count == 0 ? writeBits(encoder, time, 32)
+                               : writeDelta(encoder, delta - encoder.lastDelta);
+  for (uint8_t c = 0; ok && c < encoder.channels; c++) {
+    ok = writeDelta(encoder, values[c] - encoder.last[c]);
+  }
+
+  if (!ok) {
+    encoder.bits = start;  // Drop the partial point
+    return false;
+  }
+
+  if (encoder.count > 0) {
+    encoder.lastDelta = delta;
+  }
+  encoder.lastTime = time;
+  memcpy(encoder.last, values, encoder.channels * sizeof(int32_t));
+  encoder.count++;
+  return true;
+}
+
+size_t seriesLength(const SeriesEncoder& encoder) {
+  // Clear the pad bits of the last byte (rollbacks may have left some set)
+  if (encoder.bits % 8) {
+    encoder.data[encoder.bits / 8] &= (1 << (encoder.bits % 8)) - 1;
+  }
+  return (encoder.bits + 7) / 8;
+}
+
+// ========================================
+// Decoder
+// ========================================
+
+static bool readBits(SeriesDecoder& decoder, uint8_t count, uint32_t* value) {
+  if (decoder.bits + count > decoder.length * 8) {
+    return false;
+  }
+
+  *value = 0;
+  for (uint8_t i = 0; i < count; i++, decoder.bits++) {
+    if (decoder.data[decoder.bits / 8] & (1 << (decoder.bits % 8))) {
+      *value |= 1UL << i;
+    }
+  }
+  return true;
+}
+
+static bool readDelta(SeriesDecoder& decoder, int32_t* delta) {
+  uint8_t bucket = 0;
+  uint32_t bit = 1;
+  while (bucket < 4) {
+    if (!readBits(decoder, 1, &bit)) return false;
+    if (bit == 0) break;
+    bucket++;
+  }
+
+  uint32_t zigzag;
+  if (!readBits(decoder, bucketBits[bucket], &zigzag)) {
+    return false;
+  }
+  *delta = (int32_t)((zigzag >> 1) ^ (0 - (zigzag & 1)));
+  return true;
+}
+
+void seriesDecodeBegin(SeriesDecoder& decoder, const uint8_t* data, size_t length,
+                       uint8_t channels, uint16_t count) {
+  decoder.data = data;
+  decoder.length = length;
+  decoder.bits = 0;
+  decoder.channels = min(channels, (uint8_t)SERIES_MAX_CHANNELS);
+  decoder.remaining = count;
+  decoder.index = 0;
+  decoder.lastTime = 0;
+  decoder.lastDelta = 0;
+  memset(decoder.last, 0, sizeof(decoder.last));
+}
+
+bool seriesNext(SeriesDecoder& decoder, uint32_t* time, int32_t* values) {
+  if (decoder.remaining == 0) {
+    return false;
+  }
+
+  if (decoder.index == 0) {
+    if (!readBits(decoder, 32, &decoder.lastTime)) return false;
+  } else {
+    int32_t dod;
+    if (!readDelta(decoder, &dod)) return false;
+    decoder.lastDelta += dod;
+    decoder.lastTime += decoder.lastDelta;
+  }
+
+  for (uint8_t c = 0; c < decoder.channels; c++) {
+    int32_t delta;
+    if (!readDelta(decoder, &delta)) return false;
+    decoder.last[c] += delta;
+    values[c] = decoder.last[c];
+  }
+
+  *time = decoder.lastTime;
+  decoder.index++;
+  decoder.remaining--;
+  return true;
+}
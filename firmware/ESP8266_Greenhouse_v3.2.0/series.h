@@ -0,0 +1,63 @@
+#ifndef SERIES_H
+#define SERIES_H
+
+#include <Arduino.h>
+
+// Bit-packed sample series (Gorilla style, for fixed-point values): used for
+// the on-flash history blocks and for uploading a backlog of samples.
+// Per point: the time as delta-of-delta (the first point: 32 bit raw), then
+// each channel value as delta from the previous point (from 0 for the first).
+// Deltas are zigzag coded into one of five buckets:
+//   0      -> "0"
+//   < 2^4  -> "10"   + 4 bits
+//   < 2^8  -> "110"  + 8 bits
+//   < 2^12 -> "1110" + 12 bits
+//   else   -> "1111" + 32 bits
+// Bits are written least significant first within each byte (like
+// PostgreSQL get_bit(), see decode_sample_series() in the backend).
+// A steady 30 s sample with unchanged values costs 1 bit + 1 bit per channel.
+// The point count is stored by the caller: trailing pad bits would decode
+// as extra points.
+
+#define SERIES_ENCODING "dod-delta-v1"
+#define SERIES_MAX_CHANNELS 2
+
+struct SeriesEncoder {
+  uint8_t* data;
+  size_t capacity;         // Bytes
+  size_t bits;             // Written so far
+  uint8_t channels;
+  uint16_t count;          // Points
+  uint32_t lastTime;
+  int32_t lastDelta;
+  int32_t last[SERIES_MAX_CHANNELS];
+};
+
+struct SeriesDecoder {
+  const uint8_t* data;
+  size_t length;           // Bytes
+  size_t bits;             // Read so far
+  uint8_t channels;
+  uint16_t remaining;      // Points
+  uint16_t index;
+  uint32_t lastTime;
+  int32_t lastDelta;
+  int32_t last[SERIES_MAX_CHANNELS];
+};
+
+void seriesBegin(SeriesEncoder& encoder, uint8_t* buffer, size_t capacity, uint8_t channels);
+
+// Add a point (times must not decrease). False if it does not fit
+// (the series is unchanged and can be closed).
+bool seriesAppend(SeriesEncoder& encoder, uint32_t time, const int32_t* values);
+
+// Encoded bytes (last byte padded with 0 bits)
+size_t seriesLength(const SeriesEncoder& encoder);
+
+void seriesDecodeBegin(SeriesDecoder& decoder, const uint8_t* data, size_t length,
+                       uint8_t channels, uint16_t count);
+
+// Next point, false at the end or on malformed data
+bool seriesNext(SeriesDecoder& decoder, uint32_t* time, int32_t* values);
+
+#endif
@@ -0,0 +1,126 @@
+#include "snapshot.h"
+#include <stdarg.h>
+
+SnapshotWriter::SnapshotWriter() : data(nullptr), length(0), capacity(0), error(false) {
+}
+
+SnapshotWriter::~SnapshotWriter() {
+  free(data);
+}
+
+bool SnapshotWriter::reserve(size_t size) {
+  if (error) {
+    return false;
+  }
+  if (size <= capacity) {
+    return true;
+  }
+
+  size_t grown = max(capacity * 2, max(size, (size_t)SNAPSHOT_MIN_CAPACITY));
+  char* buffer = (char*)realloc(data, grown);
+  if (buffer == nullptr) {
+    error = true;
+    return false;
+  }
+  data = buffer;
+  capacity = grown;
+  return true;
+}
+
+size_t SnapshotWriter::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t SnapshotWriter::write(const uint8_t* bytes, size_t n) {
+  if (!reserve(length + n)) {
+    return 0;
+  }
+  memcpy(data + length, bytes, n);
+  length += n;
+  return n;
+}
+
+size_t SnapshotWriter::printf(const char* format, ...) {
+  va_list args;
+
+  // Format in place; if it does not fit, grow once and format again
+  for (int attempt = 0; attempt < 2; attempt++) {
+    va_start(args, format);
+    int n = vsnprintf(data + length, capacity - length, format, args);
+    va_end(args);
+
+    if (n < 0) {
+      return 0;
+    }
+    if (length + n < capacity) {
+      length += n;
+      return n;
+    }
+    if (!reserve(length + n + 1)) {
+      return 0;
+    }
+  }
+  return 0;
+}
+
+bool refreshSnapshot(Snapshot& snapshot, void (*writer)(SnapshotWriter&), uint32_t version) {
+  if (snapshot.data && snapshot.version == version) {
+    return true;
+  }
+
+  SnapshotWriter out;
+  writer(out);
+  if (out.failed()) {
+    Serial.printf("Snapshot: low heap (%u bytes), not rebuilt\n", ESP.getFreeHeap());
+    return false;
+  }
+
+  // Shrink to fit, the buffer now lives as long as its last response
+  char* body = (char*)realloc(out.data, max(out.length, (size_t)1));
+  if (body == nullptr) {
+    body = out.data;
+  }
+  out.data = nullptr;
+
+  snapshot.data = std::shared_ptr<const char>(body, [](const char* p) { free((void*)p); });
+  snapshot.length = out.length;
+  snapshot.version = version;
+  snapshot.builtAt = millis();
+  return true;
+}
+
+void serveSnapshot(AsyncWebServerRequest* request, Snapshot& snapshot,
+                   void (*writer)(SnapshotWriter&), uint32_t version, const char* contentType) {
+  if (!refreshSnapshot(snapshot, writer, version) && !snapshot.data) {
+    AsyncWebServerResponse* response = request->beginResponse(503, "text/plain", "Low memory");
+    response->addHeader("Retry-After", "5");
+    request->send(response);
+    return;
+  }
+
+  // Unchanged since the client's copy
+  char etag[16];
+  snprintf(etag, sizeof(etag), "\"%lx\"", (unsigned long)snapshot.version);
+  if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == etag) {
+    request->send(304);
+    return;
+  }
+
+  // The response keeps its own reference: a rebuild meanwhile is safe
+  std::shared_ptr<const char> data = snapshot.data;
+  size_t length = snapshot.length;
+  AsyncWebServerResponse* response = request->beginResponse(contentType, length,
+      [data, length](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+        size_t n = min(maxLen, length - index);
+        memcpy(buffer, data.get() + index, n);
+        return n;
+      });
+  response->addHeader("ETag", etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+uint32_t liveVersion(const Snapshot& snapshot, unsigned long maxAge) {
+  bool stale = millis() - snapshot.builtAt >= maxAge;
+  return snapshot.version + (stale ? 1 : 0);
+}
@@ -0,0 +1,65 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <memory>
+
+// Cached response body for the async web server. A snapshot is written
+// once into a growing heap buffer (SnapshotWriter) and then shared by every
+// response that sends it: each response holds a reference, so a rebuild
+// while an earlier response is still being sent does not free its data.
+//
+//   static Snapshot status;
+//   serveSnapshot(request, status, writeStatus, version, "application/json");
+
+#define SNAPSHOT_MIN_CAPACITY 256
+
+struct Snapshot;
+
+class SnapshotWriter : public Print {
+ public:
+  SnapshotWriter();
+  ~SnapshotWriter();
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* data, size_t length) override;
+  using Print::write;
+
+  // Formatted output straight into the buffer (Print::printf may use the heap)
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+  bool failed() const { return error; }
+
+ private:
+  friend bool refreshSnapshot(Snapshot& snapshot, void (*writer)(SnapshotWriter&), uint32_t version);
+  bool reserve(size_t size);
+
+  char* data;
+  size_t length;
+  size_t capacity;
+  bool error;
+};
+
+struct Snapshot {
+  std::shared_ptr<const char> data;  // nullptr = never built
+  size_t length;
+  uint32_t version;
+  unsigned long builtAt;   // millis()
+};
+
+// Rebuild the snapshot with writer unless it already holds this version.
+// Returns false if the heap could not hold the new body (the previous
+// snapshot, if any, is kept and can still be sent).
+bool refreshSnapshot(Snapshot& snapshot, void (*writer)(SnapshotWriter&), uint32_t version);
+
+// Answer an async request from the snapshot (refreshed first): 304 when the
+// client's ETag is current, 503 if it was never built for lack of heap.
+// Runs in the TCP context, it only formats on a new version.
+void serveSnapshot(AsyncWebServerRequest* request, Snapshot& snapshot,
+                   void (*writer)(SnapshotWriter&), uint32_t version, const char* contentType);
+
+// Version for live values: a new one once the snapshot is older than maxAge (ms)
+uint32_t liveVersion(const Snapshot& snapshot, unsigned long maxAge);
+
+#endif
@@ -0,0 +1,86 @@
+#include "timesync.h"
+#include <coredecls.h>
+#include <sys/time.h>
+#include <time.h>
+
+static uint32_t lastMillis = 0;
+static uint32_t millisRollovers = 0;
+
+// Last SNTP sync: epoch ms and uptime ms at the same instant
+static bool synced = false;
+static uint64_t syncEpochMs = 0;
+static uint64_t syncUptimeMs = 0;
+
+static void onTimeSet(bool fromSntp) {
+  if (!fromSntp) {
+    return;
+  }
+
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+
+  uint64_t uptime = uptimeMs();
+  uint64_t epochMs = (uint64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+
+  if (synced) {
+    // Drift since the previous sync, just for the log
+    int64_t drift = (int64_t)(epochMs - syncEpochMs) - (int64_t)(uptime - syncUptimeMs);
+    Serial.printf("SNTP resync, drift %lld ms\n", (long long)drift);
+  } else {
+    time_t now = tv.tv_sec;
+    Serial.printf("SNTP synced: %s", ctime(&now));
+  }
+
+  syncEpochMs = epochMs;
+  syncUptimeMs = uptime;
+  synced = true;
+}
+
+void initializeTime() {
+  settimeofday_cb(onTimeSet);
+  configTime(TIME_ZONE, NTP_SERVER_1, NTP_SERVER_2);
+  Serial.println("SNTP started");
+}
+
+void updateTime() {
+  uptimeMs();
+}
+
+bool timeSynced() {
+  return synced;
+}
+
+uint64_t uptimeMs() {
+  uint32_t now = millis();
+  if (now < lastMillis) {
+    millisRollovers++;
+  }
+  lastMillis = now;
+  return ((uint64_t)millisRollovers << 32) | now;
+}
+
+uint64_t epochMsAt(uint32_t millisStamp) {
+  if (!synced) {
+    return 0;
+  }
+
+  // Unsigned difference is rollover safe for stamps younger than ~49 days
+  uint64_t stampUptime = uptimeMs() - (uint32_t)(millis() - millisStamp);
+  return syncEpochMs + stampUptime - syncUptimeMs;  // Also valid for stamps before the sync
+}
+
+bool formatTimestamp(uint32_t millisStamp, char* out, size_t size) {
+  uint64_t epochMs = epochMsAt(millisStamp);
+  if (epochMs == 0) {
+    return false;
+  }
+
+  time_t seconds = epochMs / 1000;
+  struct tm utc;
+  gmtime_r(&seconds, &utc);
+
+  snprintf(out, size, "%04d-%02d-%02dT%02d:%02d:%02d.%03uZ",
+           utc.tm_year + 1900, utc.tm_mon + 1, utc.tm_mday,
+           utc.tm_hour, utc.tm_min, utc.tm_sec, (unsigned)(epochMs % 1000));
+  return true;
+}
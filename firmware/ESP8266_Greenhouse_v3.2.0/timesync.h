@@ -0,0 +1,35 @@
+#ifndef TIMESYNC_H
+#define TIMESYNC_H
+
+#include <Arduino.h>
+
+// SNTP time sync and millis() -> epoch mapping.
+// Samples are stamped with millis() when taken; the epoch time is derived
+// when they are sent, from the last SNTP sync point and the 64 bit uptime
+// (millis() rollover every ~49.7 days is tracked by updateTime()).
+// Before the first sync there is no epoch time: readings carry the
+// millis() stamp instead and the server rebases them on the uptime_ms of
+// the request.
+
+#define NTP_SERVER_1 "pool.ntp.org"
+#define NTP_SERVER_2 "time.google.com"
+#define TIME_ZONE "CET-1CEST,M3.5.0,M10.5.0/3"  // Local time for rules (Europe/Rome)
+
+// Start SNTP (runs in the background once WiFi is up)
+void initializeTime();
+
+// Track millis() rollover, call every loop
+void updateTime();
+
+bool timeSynced();
+
+// Milliseconds since boot, does not roll over
+uint64_t uptimeMs();
+
+// Epoch time in ms of a recent millis() stamp (0 if not synced)
+uint64_t epochMsAt(uint32_t millisStamp);
+
+// ISO 8601 UTC timestamp of a millis() stamp ("2025-11-26T10:15:30.250Z")
+bool formatTimestamp(uint32_t millisStamp, char* out, size_t size);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// Backend transport used by heartbeat, sensors and commands.
+// TRANSPORT_HTTP: HTTPS POST to Supabase PostgREST RPC functions (default)
+// TRANSPORT_MQTT: publish/subscribe on a local MQTT broker
+// Select at build time, e.g. -DTRANSPORT=TRANSPORT_MQTT
+#define TRANSPORT_HTTP 0
+#define TRANSPORT_MQTT 1
+
+#ifndef TRANSPORT
+#define TRANSPORT TRANSPORT_HTTP
+#endif
+
+// RPC names (PostgREST function names)
+#define RPC_HEARTBEAT "device_heartbeat_with_config_v3"
+#define RPC_GET_CONFIG "get_device_sensor_config"
+#define RPC_GET_CONTROL_CONFIG "get_device_control_config"
+#define RPC_INSERT_READINGS "insert_sensor_readings"
+#define RPC_ACK_COMMANDS "acknowledge_device_commands"
+
+enum TransportAuth {
+  AUTH_ANON,        // apikey + Bearer anon key
+  AUTH_DEVICE_KEY   // apikey + x-device-key
+};
+
+void setupTransport();
+void handleTransport();
+bool transportConnected();
+
+// Call rpc with a JSON body. If response is not null it receives the result.
+// Returns true when the backend accepted the call.
+bool transportCall(const char* rpc, const JsonDocument& request,
+                   JsonDocument* response, TransportAuth auth = AUTH_ANON);
+
+#endif
@@ -0,0 +1,268 @@
+#include "transport.h"
+#include "metrics.h"
+
+#if TRANSPORT == TRANSPORT_MQTT
+
+/**
+ * MQTT transport (PubSubClient)
+ *
+ * Topics (prefix serra/<composite_device_id>/):
+ *   online     <- "1" on connect, "0" as retained LWT
+ *   heartbeat  <- {composite_device_id_param, firmware_version_param, ...}
+ *   readings   <- telemetry batch {readings: [...], uptime_ms}
+ *   acks       <- {composite_device_id_param, acks_param: [...]}
+ *   config          -> retained {config_version}
+ *   config/sensors  -> retained [{sensor_type, port_id, calibration}]
+ *   config/control  -> retained {actuators, loops, rules, schedules}
+ *   commands        -> {id, type, payload} (QoS 1, kept by broker while offline)
+ *
+ * The config parts are the get_device_sensor_config / get_device_control_config
+ * responses, one retained message each so none of them has to hold the whole
+ * config. Publish both parts before the new config_version. The device only
+ * subscribes to a part while fetching it: the retained message is parsed
+ * straight into the caller's document, and the larger receive buffer it
+ * needs is held for that call only.
+ *
+ * Local test with mosquitto:
+ *   mosquitto -v
+ *   mosquitto_sub -t 'serra/#' -v
+ *   mosquitto_pub -r -t serra/PROJ1-ESP1/config/sensors \
+ *     -m '[{"sensor_type":"dht_sopra_temp","port_id":"D2"}]'
+ *   mosquitto_pub -r -t serra/PROJ1-ESP1/config/control -m '{"actuators":[]}'
+ *   mosquitto_pub -r -t serra/PROJ1-ESP1/config -m '{"config_version":2}'
+ *   mosquitto_pub -q 1 -t serra/PROJ1-ESP1/commands \
+ *     -m '{"id":"00000000-0000-0000-0000-000000000001","type":"reset","payload":{}}'
+ *
+ * Note: PubSubClient publishes at QoS 0 only. Telemetry and acks are sent as
+ * one batch message per call; a failed publish stays with the caller and is
+ * retried like on the HTTP transport. A successful publish only means the
+ * message was written to the socket: a batch in flight when the connection
+ * drops is lost without notice (there is no broker-side ack to wait for).
+ */
+
+#include <ESP8266WiFi.h>
+#include <PubSubClient.h>
+#include "commands.h"
+
+#ifndef MQTT_HOST
+#define MQTT_HOST "192.168.1.10"
+#endif
+#ifndef MQTT_PORT
+#define MQTT_PORT 1883
+#endif
+#ifndef MQTT_USER
+#define MQTT_USER nullptr
+#endif
+#ifndef MQTT_PASSWORD
+#define MQTT_PASSWORD nullptr
+#endif
+
+#define MQTT_TOPIC_ROOT "serra/"
+#define MQTT_BUFFER_SIZE 2048           // Commands; larger messages are dropped
+#define MQTT_CONFIG_BUFFER_SIZE (4096 + 128)  // While fetching a config part: largest
+                                        // part (heartbeat.cpp control config document)
+                                        // + topic and header
+#define MQTT_CONFIG_TIMEOUT 3000        // ms to wait for a retained config part
+#define MQTT_KEEPALIVE 30               // seconds
+#define MQTT_RECONNECT_INTERVAL 5000    // ms between connection attempts
+
+static WiFiClient mqttNetClient;
+static PubSubClient mqttClient(mqttNetClient);
+static unsigned long lastReconnectAttempt = 0;
+
+static int cloudConfigVersion = -1;
+
+// Config part being fetched by transportCall()
+static const char* pendingPart = nullptr;      // "sensors" / "control"
+static JsonDocument* pendingPartDoc = nullptr;
+static bool pendingPartReceived = false;
+static bool pendingPartValid = false;
+
+static void buildTopic(char* out, size_t size, const char* suffix) {
+  snprintf(out, size, MQTT_TOPIC_ROOT "%s/%s", deviceConfig.composite_device_id, suffix);
+}
+
+// Map RPC name to topic suffix
+static const char* rpcTopic(const char* rpc) {
+  if (strcmp(rpc, RPC_HEARTBEAT) == 0) return "heartbeat";
+  if (strcmp(rpc, RPC_INSERT_READINGS) == 0) return "readings";
+  if (strcmp(rpc, RPC_ACK_COMMANDS) == 0) return "acks";
+  return rpc;
+}
+
+static void onMqttMessage(char* topic, uint8_t* payload, unsigned int length) {
+  const char* suffix = strrchr(topic, '/');
+  if (!suffix) return;
+  suffix++;
+
+  // config/sensors, config/control: parsed into the waiting caller's document
+  // (const char*: strings are copied out of the receive buffer)
+  if (strcmp(suffix, "sensors") == 0 || strcmp(suffix, "control") == 0) {
+    if (!pendingPart || strcmp(suffix, pendingPart) != 0 || pendingPartReceived) {
+      return;
+    }
+    DeserializationError error = deserializeJson(*pendingPartDoc, (const char*)payload, length);
+    if (error) {
+      Serial.printf("MQTT: invalid config/%s payload: %s\n", suffix, error.c_str());
+    }
+    pendingPartReceived = true;
+    pendingPartValid = !error;
+    return;
+  }
+
+  if (strcmp(suffix, "config") == 0) {
+    StaticJsonDocument<64> filter;
+    filter["config_version"] = true;
+    StaticJsonDocument<64> doc;
+    if (!deserializeJson(doc, (const char*)payload, length, DeserializationOption::Filter(filter))) {
+      cloudConfigVersion = doc["config_version"] | -1;
+      Serial.printf("MQTT: config received (version %d)\n", cloudConfigVersion);
+    }
+    return;
+  }
+
+  if (strcmp(suffix, "commands") == 0) {
+    DynamicJsonDocument doc(1024);
+    DeserializationError error = deserializeJson(doc, (const char*)payload, length);
+    if (error) {
+      Serial.printf("MQTT: command parse error: %s\n", error.c_str());
+      return;
+    }
+    Serial.println("MQTT: command received");
+    enqueueCommand(parseCommand(doc.as<JsonObject>()));
+  }
+}
+
+static bool connectMqtt() {
+  char onlineTopic[48];
+  char topic[48];
+  buildTopic(onlineTopic, sizeof(onlineTopic), "online");
+
+  Serial.printf("MQTT: connecting to %s:%d...\n", MQTT_HOST, MQTT_PORT);
+
+  // Persistent session: broker keeps QoS 1 commands while device is offline
+  if (!mqttClient.connect(deviceConfig.composite_device_id, MQTT_USER, MQTT_PASSWORD,
+                          onlineTopic, 1, true, "0", false)) {
+    Serial.printf("MQTT: connection failed, state=%d\n", mqttClient.state());
+    return false;
+  }
+
+  mqttClient.publish(onlineTopic, "1", true);
+
+  buildTopic(topic, sizeof(topic), "config");
+  mqttClient.subscribe(topic, 1);
+  buildTopic(topic, sizeof(topic), "commands");
+  mqttClient.subscribe(topic, 1);
+
+  Serial.println("MQTT: connected");
+  return true;
+}
+
+void setupTransport() {
+  Serial.printf("Transport: MQTT (%s:%d)\n", MQTT_HOST, MQTT_PORT);
+
+  mqttClient.setServer(MQTT_HOST, MQTT_PORT);
+  mqttClient.setCallback(onMqttMessage);
+  mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
+  mqttClient.setKeepAlive(MQTT_KEEPALIVE);
+
+  connectMqtt();
+  lastReconnectAttempt = millis();
+}
+
+void handleTransport() {
+  if (WiFi.status() != WL_CONNECTED) {
+    return;
+  }
+
+  if (!mqttClient.connected()) {
+    if (millis() - lastReconnectAttempt >= MQTT_RECONNECT_INTERVAL) {
+      lastReconnectAttempt = millis();
+      connectMqtt();
+    }
+    return;
+  }
+
+  mqttClient.loop();
+}
+
+bool transportConnected() {
+  return mqttClient.connected();
+}
+
+// Subscribe to a retained config part until the broker has delivered it
+// into doc (the caller's document, sized for the same response on HTTP)
+static bool fetchConfigPart(const char* part, JsonDocument& doc) {
+  if (!mqttClient.setBufferSize(MQTT_CONFIG_BUFFER_SIZE)) {
+    Serial.println("MQTT: no memory for the config buffer");
+    mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
+    return false;
+  }
+
+  char suffix[16];
+  char topic[64];
+  snprintf(suffix, sizeof(suffix), "config/%s", part);
+  buildTopic(topic, sizeof(topic), suffix);
+
+  pendingPart = part;
+  pendingPartDoc = &doc;
+  pendingPartReceived = false;
+  pendingPartValid = false;
+
+  unsigned long started = millis();
+  if (mqttClient.subscribe(topic, 1)) {
+    while (!pendingPartReceived && mqttClient.connected() &&
+           millis() - started < MQTT_CONFIG_TIMEOUT) {
+      mqttClient.loop();
+      delay(10);
+    }
+    mqttClient.unsubscribe(topic);
+  }
+
+  if (!pendingPartReceived) {
+    Serial.printf("MQTT: no retained %s\n", suffix);
+  }
+  pendingPart = nullptr;
+  pendingPartDoc = nullptr;
+  mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
+  return pendingPartValid;
+}
+
+bool transportCall(const char* rpc, const JsonDocument& request,
+                   JsonDocument* response, TransportAuth auth) {
+  if (!mqttClient.connected()) {
+    Serial.printf("MQTT not connected, skipping %s\n", rpc);
+    return false;
+  }
+
+  // Config comes from the retained config part topics
+  if (strcmp(rpc, RPC_GET_CONFIG) == 0 || strcmp(rpc, RPC_GET_CONTROL_CONFIG) == 0) {
+    return response != nullptr &&
+           fetchConfigPart(strcmp(rpc, RPC_GET_CONFIG) == 0 ? "sensors" : "control", *response);
+  }
+
+  char topic[64];
+  buildTopic(topic, sizeof(topic), rpcTopic(rpc));
+
+  unsigned long started = millis();
+  size_t length = measureJson(request);
+  if (!mqttClient.beginPublish(topic, length, false)) {
+    Serial.printf("MQTT: publish to %s failed\n", topic);
+    recordRpc(rpc, false, millis() - started);
+    return false;
+  }
+  serializeJson(request, mqttClient);
+  bool ok = mqttClient.endPublish() == 1;
+  recordRpc(rpc, ok, millis() - started);
+
+  // Heartbeat response is built locally: config version from retained
+  // topic, commands are pushed on the command topic
+  if (ok && response != nullptr && strcmp(rpc, RPC_HEARTBEAT) == 0) {
+    (*response)["success"] = true;
+    (*response)["config_version"] = cloudConfigVersion;
+  }
+
+  return ok;
+}
+
+#endif
@@ -1,101 +1,413 @@
 #include "webserver.h"
 #include "sensors.h"
+#include "ota.h"
+#include "commands.h"
+#include "control.h"
+#include "actuators.h"
+#include "rules.h"
+#include "timesync.h"
+#include "schedules.h"
+#include "webui_assets.h"
+#include "snapshot.h"
+#include "metrics.h"
+#include "events.h"
+#include "history.h"
 #include <Arduino.h>
+#include <ESP8266mDNS.h>
+#include <ArduinoJson.h>
 
-ESP8266WebServer server(80);
+AsyncWebServer server(80);
+
+static void sendAsset(AsyncWebServerRequest* request, const WebAsset& asset);
 
 void setupWebServer() {
-  server.on("/", HTTP_GET, handleRoot);
-  server.on("/config", HTTP_GET, handleConfig);
+  // Web UI pages, CSS and JS (gzip in flash), values from /api/*
+  for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+    const WebAsset& asset = webAssets[i];
+    server.on(asset.path, HTTP_GET, [&asset](AsyncWebServerRequest* request) { sendAsset(request, asset); });
+  }
+  server.on("/api/status", HTTP_GET, handleStatusJson);
+  server.on("/api/config", HTTP_GET, handleConfigJson);
+  server.on("/api/readings", HTTP_GET, handleReadingsJson);
+  server.on("/api/history", HTTP_GET, handleHistoryJson);
+  server.on("/metrics", HTTP_GET, handleMetrics);
+  server.on("/firmware/info", HTTP_GET, handleFirmwareInfo);
+  server.on("/firmware.bin", HTTP_GET, handleFirmwareImage);
   server.onNotFound(handleNotFound);
+  setupEvents();
 
   server.begin();
-  Serial.println("Web server started on port 80");
-}
-
-void handleRoot() {
-  String html = "<!DOCTYPE html><html><head>";
-  html += "<meta charset='UTF-8'>";
-  html += "<meta name='viewport' content='width=device-width, initial-scale=1'>";
-  html += "<title>Serra ESP8266</title>";
-  html += "<style>";
-  html += "body{font-family:Arial,sans-serif;max-width:800px;margin:50px auto;padding:20px;background:#f5f5f5}";
-  html += "h1{color:#2c3e50}table{width:100%;border-collapse:collapse;background:white}";
-  html += "td,th{padding:12px;text-align:left;border-bottom:1px solid #ddd}";
-  html += "th{background:#3498db;color:white}.btn{display:inline-block;padding:10px 20px;";
-  html += "background:#3498db;color:white;text-decoration:none;border-radius:5px;margin:10px 5px}";
-  html += ".btn:hover{background:#2980b9}.new{background:#27ae60;padding:2px 8px;border-radius:3px;font-size:12px;margin-left:5px}</style></head><body>";
-
-  html += "<h1>Serra ESP8266 v3.2.0 <span class='new'>NEW</span></h1>";
-  html += "<table>";
-  html += "<tr><th>Parametro</th><th>Valore</th></tr>";
-  html += "<tr><td><b>Device ID</b></td><td>" + String(deviceConfig.composite_device_id) + "</td></tr>";
-  html += "<tr><td><b>Firmware</b></td><td>v3.2.0 (Remote Management)</td></tr>";
-  html += "<tr><td><b>WiFi SSID</b></td><td>" + WiFi.SSID() + "</td></tr>";
-  html += "<tr><td><b>IP Address</b></td><td>" + WiFi.localIP().toString() + "</td></tr>";
-  html += "<tr><td><b>RSSI</b></td><td>" + String(WiFi.RSSI()) + " dBm</td></tr>";
-  html += "<tr><td><b>Uptime</b></td><td>" + String(millis() / 1000) + " sec</td></tr>";
-  html += "<tr><td><b>WiFi Backup</b></td><td>" + String(hasValidWiFiBackup() ? "Available" : "None") + "</td></tr>";
-  html += "</table>";
-
-  html += "<br><a href='/config' class='btn'>Configura Sensori</a>";
-  html += "</body></html>";
-
-  server.send(200, "text/html", html);
-}
-
-void handleConfig() {
-  String html = "<!DOCTYPE html><html><head>";
-  html += "<meta charset='UTF-8'>";
-  html += "<meta name='viewport' content='width=device-width, initial-scale=1'>";
-  html += "<title>Configurazione Sensori</title>";
-  html += "<style>";
-  html += "body{font-family:Arial,sans-serif;max-width:800px;margin:50px auto;padding:20px;background:#f5f5f5}";
-  html += "h1{color:#2c3e50}.sensor{background:white;padding:20px;margin:15px 0;border-radius:8px;box-shadow:0 2px 4px rgba(0,0,0,0.1)}";
-  html += ".info{background:#e8f5e9;padding:15px;border-left:4px solid #27ae60;margin:20px 0}</style></head><body>";
-
-  html += "<h1>Configurazione Sensori (Read-Only)</h1>";
-  html += "<p>Device ID: <strong>" + String(deviceConfig.composite_device_id) + "</strong></p>";
-
-  html += "<div class='info' style='background:#fff3cd;border-left-color:#ffc107'>";
-  html += "<strong>Configurazione Cloud Attiva</strong><br>";
-  html += "I sensori sono configurati dalla webapp. Per modificare la configurazione, usa la dashboard web.";
-  html += "</div>";
-
-  html += "<div class='info'>Config Version: " + String(deviceConfig.config_version) + "</div>";
+  Serial.println("Web server started on port 80 (async)");
+
+  // Advertise on the LAN: serra-<device id>.local + firmware sharing service
+  String hostname = "serra-" + String(deviceConfig.composite_device_id);
+  hostname.toLowerCase();
+  if (MDNS.begin(hostname.c_str())) {
+    MDNS.addService("http", "tcp", 80);
+    MDNS.addService("serra-fw", "tcp", 80);
+    MDNS.addServiceTxt("serra-fw", "tcp", "version", FIRMWARE_VERSION);
+    Serial.printf("mDNS: %s.local\n", hostname.c_str());
+  }
+}
+
+// ========================================
+// Web UI: static files from flash + JSON values
+// ========================================
+
+// Gzip file straight from PROGMEM (no heap copy), revalidated by ETag
+static void sendAsset(AsyncWebServerRequest* request, const WebAsset& asset) {
+  if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == asset.etag) {
+    request->send(304);
+    return;
+  }
+
+  AsyncWebServerResponse* response = request->beginResponse_P(200, asset.contentType, asset.data, asset.length);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", asset.etag);
+  response->addHeader("Cache-Control", asset.immutable ? "public, max-age=31536000, immutable" : "no-cache");
+  request->send(response);
+}
+
+// ========================================
+// Local JSON API: cached pre-serialized snapshots
+// ========================================
+// Each endpoint keeps its last serialized response (snapshot.h). It is
+// rebuilt only when its source changes (config_version, new sample) or,
+// for live values, once per second; other requests are answered from the
+// buffer with no sensor access or serialization.
+// Handlers run in the TCP stack's context (between loop() steps, also while
+// loop() waits on a backend call), so they never block or delay.
+
+#define STATUS_SNAPSHOT_MAX_AGE 1000  // ms (uptime, RSSI, actuator outputs)
+#define METRICS_SNAPSHOT_MAX_AGE 1000
 
+static Snapshot statusSnapshot;
+static Snapshot configSnapshot;
+static Snapshot readingsSnapshot;
+static Snapshot metricsSnapshot;
+
+// Array element from a small per-item document (bounded memory per item)
+static void writeItem(Print& out, const JsonDocument& item, bool* first) {
+  if (!*first) {
+    out.write(',');
+  }
+  *first = false;
+  serializeJson(item, out);
+}
+
+// Sample time: ISO 8601 when SNTP synced, else millis() stamp
+static void setSampleTime(JsonObject object, uint32_t readAt) {
+  char ts[32];
+  if (formatTimestamp(readAt, ts, sizeof(ts))) {
+    object["ts"] = ts;
+  } else {
+    object["uptime_ms"] = readAt;
+  }
+}
+
+static void writeStatusJson(SnapshotWriter& out) {
+  StaticJsonDocument<512> doc;
+  doc["device_id"] = deviceConfig.composite_device_id;
+  doc["firmware"] = FIRMWARE_VERSION;
+  doc["ssid"] = WiFi.SSID();
+  doc["ip"] = WiFi.localIP().toString();
+  doc["rssi"] = WiFi.RSSI();
+  doc["uptime_s"] = millis() / 1000;
+  doc["wifi_backup"] = hasValidWiFiBackup();
+  doc["free_heap"] = ESP.getFreeHeap();
+
+  char ts[32];
+  if (formatTimestamp(millis(), ts, sizeof(ts))) {
+    doc["time"] = ts;
+  }
+
+  if (commandJobStatus() != JOB_IDLE) {
+    JsonObject command = doc.createNestedObject("last_command");
+    command["type"] = commandJobType();
+    command["status"] = commandJobStatusName(commandJobStatus());
+  }
+
+  // Open the document and append the live arrays item by item
+  doc["actuators"] = nullptr;
+  size_t length = measureJson(doc);
+  char head[384];
+  if (length >= sizeof(head)) {
+    return;
+  }
+  serializeJson(doc, head, sizeof(head));
+  head[length - strlen("null}")] = '\0';  // Cut the "actuators":null placeholder value
+  out.print(head);
+
+  StaticJsonDocument<128> item;
+  bool first = true;
+  out.print("[");
+  for (uint8_t i = 0; i < controlConfig.actuator_count; i++) {
+    item.clear();
+    item["actuator_id"] = controlConfig.actuators[i].actuator_id;
+    item["output"] = (int)(actuatorOutput(i) + 0.5f);
+    item["manual"] = actuatorManualHold(i);
+    item["tripped"] = actuatorTripped(i);
+    item["remaining_s"] = actuatorRemainingSeconds(i);
+    writeItem(out, item, &first);
+  }
+
+  out.print("],\"loop_outputs\":[");
+  for (int i = 0; i < controlConfig.loop_count; i++) {
+    out.printf("%s%d", i ? "," : "", (int)(controlOutput(i) + 0.5f));
+  }
+  out.print("],\"rules_active\":[");
+  for (int i = 0; i < ruleProgram.rule_count; i++) {
+    out.print(i ? "," : "");
+    out.print(ruleActive(i) ? "true" : "false");
+  }
+  out.print("],\"schedules_running\":[");
+  for (int i = 0; i < scheduleTable.count; i++) {
+    out.print(i ? "," : "");
+    out.print(scheduleRunning(i) ? "true" : "false");
+  }
+  out.print("]}");
+}
+
+// Configuration only (changes with config_version)
+static void writeConfigJson(SnapshotWriter& out) {
+  StaticJsonDocument<256> item;
+  bool first;
+
+  out.printf("{\"device_id\":\"%s\",\"config_version\":%d,\"time_synced\":%s,\"sensors\":[",
+             deviceConfig.composite_device_id, deviceConfig.config_version,
+             timeSynced() ? "true" : "false");
+  first = true;
   for (int i = 0; i < MAX_SENSORS; i++) {
     if (deviceConfig.sensors[i].type == 0) continue;
 
-    html += "<div class='sensor'>";
-    html += "<h3>Sensore " + String(i + 1) + "</h3>";
-    html += "<table style='width:100%;background:transparent'>";
-    html += "<tr><td><strong>Pin GPIO:</strong></td><td>" + String(deviceConfig.sensors[i].pin) + "</td></tr>";
-
-    String typeName = "Sconosciuto";
-    switch (deviceConfig.sensors[i].type) {
-      case 1: typeName = "DHT22"; break;
-      case 2: typeName = "DHT11"; break;
-      case 3: typeName = "Soil Moisture"; break;
-      case 4: typeName = "Water Level"; break;
+    item.clear();
+    item["slot"] = i + 1;
+    item["pin"] = deviceConfig.sensors[i].pin;
+    item["type"] = deviceConfig.sensors[i].type;
+    item["name"] = deviceConfig.sensors[i].name;
+    writeItem(out, item, &first);
+  }
+
+  out.print("],\"actuators\":[");
+  first = true;
+  for (uint8_t i = 0; i < controlConfig.actuator_count; i++) {
+    item.clear();
+    item["actuator_id"] = controlConfig.actuators[i].actuator_id;
+    item["pin"] = controlConfig.actuators[i].pin;
+    item["type"] = controlConfig.actuators[i].type;
+    item["ramp_ms"] = controlConfig.actuators[i].ramp_ms;
+    item["max_on_s"] = controlConfig.actuators[i].max_on_s;
+    writeItem(out, item, &first);
+  }
+
+  out.print("],\"loops\":[");
+  first = true;
+  for (int i = 0; i < controlConfig.loop_count; i++) {
+    const ControlLoop& loop = controlConfig.loops[i];
+    item.clear();
+    item["actuator_id"] = controlConfig.actuators[loop.actuator_index].actuator_id;
+    item["mode"] = loop.mode == CONTROL_PID ? "pid" : "hysteresis";
+    item["cooling"] = loop.cooling != 0;
+    item["sensor"] = deviceConfig.sensors[loop.sensor_index].name;
+    item["setpoint"] = loop.setpoint;
+    writeItem(out, item, &first);
+  }
+
+  out.print("],\"rules\":[");
+  first = true;
+  for (int i = 0; i < ruleProgram.rule_count; i++) {
+    const RuleConfig& rule = ruleProgram.rules[i];
+    item.clear();
+    item["actuator_id"] = controlConfig.actuators[rule.actuator_index].actuator_id;
+    item["value"] = rule.value;
+    item["duration_s"] = rule.duration_s;
+    writeItem(out, item, &first);
+  }
+
+  out.print("],\"schedules\":[");
+  first = true;
+  for (int i = 0; i < scheduleTable.count; i++) {
+    const ScheduleEntry& entry = scheduleTable.entries[i];
+    item.clear();
+    item["actuator_id"] = controlConfig.actuators[entry.actuator_index].actuator_id;
+    item["start_s"] = entry.start_s;
+    item["weekdays"] = entry.weekdays;
+    item["duration_s"] = entry.duration_s;
+    item["value"] = entry.value;
+    writeItem(out, item, &first);
+  }
+
+  out.print("]}");
+}
+
+// Latest valid reading per sensor + in-RAM history (oldest first)
+static void writeReadingsJson(SnapshotWriter& out) {
+  StaticJsonDocument<256> item;
+  bool first = true;
+
+  out.print("{\"latest\":[");
+  for (int i = 0; i < MAX_SENSORS; i++) {
+    const SensorReading& reading = sensorReadings[i];
+    if (deviceConfig.sensors[i].type == 0 || reading.readAt == 0) continue;
+
+    item.clear();
+    item["slot"] = i + 1;
+    item["name"] = deviceConfig.sensors[i].name;
+    setFixed(item.as<JsonObject>(), "temperature", reading.temperature, SCALE_TEMPERATURE);
+    setFixed(item.as<JsonObject>(), "humidity", reading.humidity, SCALE_HUMIDITY);
+    item["valid"] = reading.valid;
+    setSampleTime(item.as<JsonObject>(), reading.readAt);
+    writeItem(out, item, &first);
+  }
+
+  out.print("],\"history\":[");
+  first = true;
+  for (uint8_t i = 0; i < readingHistoryCount(); i++) {
+    const ReadingSample& sample = readingHistoryAt(i);
+    item.clear();
+    item["slot"] = sample.slot + 1;
+    setFixed(item.as<JsonObject>(), "temperature", sample.temperature, SCALE_TEMPERATURE);
+    setFixed(item.as<JsonObject>(), "humidity", sample.humidity, SCALE_HUMIDITY);
+    setSampleTime(item.as<JsonObject>(), sample.readAt);
+    writeItem(out, item, &first);
+  }
+
+  out.print("]}");
+}
+
+void handleStatusJson(AsyncWebServerRequest* request) {
+  serveSnapshot(request, statusSnapshot, writeStatusJson,
+                liveVersion(statusSnapshot, STATUS_SNAPSHOT_MAX_AGE), "application/json");
+}
+
+void handleConfigJson(AsyncWebServerRequest* request) {
+  serveSnapshot(request, configSnapshot, writeConfigJson, deviceConfig.config_version, "application/json");
+}
+
+void handleReadingsJson(AsyncWebServerRequest* request) {
+  serveSnapshot(request, readingsSnapshot, writeReadingsJson, sensorDataVersion, "application/json");
+}
+
+static uint32_t numberParam(AsyncWebServerRequest* request, const char* name) {
+  return request->hasParam(name) ? strtoul(request->getParam(name)->value().c_str(), nullptr, 10) : 0;
+}
+
+// On-flash history (?sensor=&from=&to=&step=, epoch s), read segment by
+// segment as the TCP window allows instead of being built in memory
+void handleHistoryJson(AsyncWebServerRequest* request) {
+  if (!request->hasParam("sensor")) {
+    request->send(400, "text/plain", "Missing sensor");
+    return;
+  }
+  if (!timeSynced()) {
+    request->send(503, "text/plain", "Time not synced");
+    return;
+  }
+  if (ESP.getMaxFreeBlockSize() < sizeof(HistoryQuery) + 2048) {
+    AsyncWebServerResponse* response = request->beginResponse(503, "text/plain", "Low memory");
+    response->addHeader("Retry-After", "5");
+    request->send(response);
+    return;
+  }
+
+  std::shared_ptr<HistoryQuery> query = std::make_shared<HistoryQuery>();
+  if (!beginHistoryQuery(*query, request->getParam("sensor")->value().c_str(), numberParam(request, "from"),
+                         numberParam(request, "to"), numberParam(request, "step"))) {
+    request->send(400, "text/plain", "Unknown sensor or invalid range");
+    return;
+  }
+
+  AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+      [query](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+        size_t n = readHistoryJson(*query, (char*)buffer, maxLen);
+        return (n == 0 && !historyQueryDone(*query)) ? RESPONSE_TRY_AGAIN : n;
+      });
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+// Prometheus scrape
+void handleMetrics(AsyncWebServerRequest* request) {
+  serveSnapshot(request, metricsSnapshot, writeMetrics,
+                liveVersion(metricsSnapshot, METRICS_SNAPSHOT_MAX_AGE), "text/plain; version=0.0.4");
+}
+
+// ========================================
+// LAN firmware sharing
+// ========================================
+
+void handleFirmwareInfo(AsyncWebServerRequest* request) {
+  if (!firmwareSharingEnabled()) {
+    request->send(503, "application/json", "{\"error\":\"image not confirmed\"}");
+    return;
+  }
+
+  // Hashed in loop() (updateImageSha256), never here
+  const char* sha256 = runningImageSha256();
+  if (!sha256) {
+    request->send(503, "application/json", "{\"error\":\"image hash not ready\"}");
+    return;
+  }
+
+  String json = "{\"version\":\"" FIRMWARE_VERSION "\",\"sha256\":\"";
+  json += sha256;
+  json += "\",\"size\":" + String(ESP.getSketchSize()) + "}";
+
+  request->send(200, "application/json", json);
+}
+
+// Copy image bytes from flash (reads must be 4-byte aligned)
+static size_t readImage(uint8_t* buffer, size_t length, uint32_t offset) {
+  uint32_t words[64];
+  size_t done = 0;
+
+  while (done < length) {
+    uint32_t aligned = offset & ~3UL;
+    uint32_t skip = offset - aligned;
+    size_t n = min((size_t)(sizeof(words) - skip), length - done);
+
+    if (!ESP.flashRead(aligned, words, (skip + n + 3) & ~3UL)) {
+      break;
     }
-    html += "<tr><td><strong>Tipo:</strong></td><td>" + typeName + "</td></tr>";
-    html += "<tr><td><strong>Nome:</strong></td><td>" + String(deviceConfig.sensors[i].name) + "</td></tr>";
-    html += "</table></div>";
+    memcpy(buffer + done, (const uint8_t*)words + skip, n);
+    done += n;
+    offset += n;
   }
+  return done;
+}
 
-  if (deviceConfig.sensors[0].type == 0 && deviceConfig.sensors[1].type == 0 &&
-      deviceConfig.sensors[2].type == 0 && deviceConfig.sensors[3].type == 0) {
-    html += "<div class='sensor' style='text-align:center;color:#999'>";
-    html += "<p>Nessun sensore configurato</p>";
-    html += "<p>Configura i sensori dalla dashboard web</p>";
-    html += "</div>";
+// Send the running image from flash, one TCP window at a time
+// (supports "Range: bytes=N-")
+void handleFirmwareImage(AsyncWebServerRequest* request) {
+  if (!firmwareSharingEnabled()) {
+    request->send(503, "text/plain", "Image not confirmed");
+    return;
   }
-  html += "</body></html>";
 
-  server.send(200, "text/html", html);
+  uint32_t size = ESP.getSketchSize();
+  uint32_t offset = 0;
+
+  if (request->hasHeader("Range")) {
+    if (sscanf(request->header("Range").c_str(), "bytes=%u-", &offset) != 1 || offset >= size) {
+      request->send(416, "text/plain", "Invalid range");
+      return;
+    }
+  }
+
+  Serial.printf("Serving firmware to %s from byte %u\n",
+                request->client()->remoteIP().toString().c_str(), offset);
+
+  AsyncWebServerResponse* response = request->beginResponse("application/octet-stream", size - offset,
+      [offset, size](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+        return readImage(buffer, min(maxLen, (size_t)(size - offset - index)), offset + index);
+      });
+  if (offset > 0) {
+    response->setCode(206);
+    response->addHeader("Content-Range", "bytes " + String(offset) + "-" + String(size - 1) + "/" + String(size));
+  }
+  request->send(response);
 }
 
-void handleNotFound() {
-  server.send(404, "text/plain", "404 - Not Found");
+void handleNotFound(AsyncWebServerRequest* request) {
+  request->send(404, "text/plain", "404 - Not Found");
 }
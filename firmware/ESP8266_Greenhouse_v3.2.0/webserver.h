@@ -1,14 +1,27 @@
 #ifndef WEBSERVER_H
 #define WEBSERVER_H
 
-#include <ESP8266WebServer.h>
+#include <ESPAsyncTCP.h>
+#include <ESPAsyncWebServer.h>
 #include "config.h"
 
-extern ESP8266WebServer server;
+// Async (callback driven) server: requests are handled by the TCP stack as
+// they arrive, not polled from loop(), so a slow client or a blocking
+// backend call in loop() does not hold up other requests.
+extern AsyncWebServer server;
 
 void setupWebServer();
-void handleRoot();
-void handleConfig();
-void handleNotFound();
+
+// Local JSON API (also used by the web UI, pages themselves are static)
+void handleStatusJson(AsyncWebServerRequest* request);    // Device status + live actuator states
+void handleConfigJson(AsyncWebServerRequest* request);    // Sensors, actuators, loops, rules, schedules
+void handleReadingsJson(AsyncWebServerRequest* request);  // Latest readings + in-RAM history
+void handleHistoryJson(AsyncWebServerRequest* request);   // Downsampled on-flash history
+void handleMetrics(AsyncWebServerRequest* request);       // Prometheus text format
+void handleNotFound(AsyncWebServerRequest* request);
+
+// LAN firmware sharing (peers prefer this over the cloud URL)
+void handleFirmwareInfo(AsyncWebServerRequest* request);
+void handleFirmwareImage(AsyncWebServerRequest* request);
 
 #endif
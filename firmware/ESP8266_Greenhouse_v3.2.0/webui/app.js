@@ -0,0 +1,143 @@
+// Static UI: pages are cached by the browser, values come from /api/*
+(function () {
+  var SENSOR_TYPES = {1: 'DHT22', 2: 'DHT11', 3: 'Soil Moisture', 4: 'Water Level'};
+  var WEEKDAYS = ['Dom', 'Lun', 'Mar', 'Mer', 'Gio', 'Ven', 'Sab'];
+
+  function $(id) { return document.getElementById(id); }
+
+  function esc(value) {
+    return String(value).replace(/[&<>'"]/g, function (c) {
+      return '&#' + c.charCodeAt(0) + ';';
+    });
+  }
+
+  function rows(pairs) {
+    return pairs.map(function (p) {
+      return '<tr><td><strong>' + esc(p[0]) + '</strong></td><td>' + esc(p[1]) + '</td></tr>';
+    }).join('');
+  }
+
+  function card(title, pairs) {
+    return '<div class="card"><h3>' + esc(title) + '</h3><table>' + rows(pairs) + '</table></div>';
+  }
+
+  function hms(seconds) {
+    function pad(n) { return (n < 10 ? '0' : '') + n; }
+    return pad(Math.floor(seconds / 3600)) + ':' + pad(Math.floor(seconds / 60) % 60) + ':' + pad(seconds % 60);
+  }
+
+  function get(url, done) {
+    var xhr = new XMLHttpRequest();
+    xhr.onload = function () {
+      if (xhr.status === 200) done(JSON.parse(xhr.responseText));
+    };
+    xhr.open('GET', url);
+    xhr.send();
+  }
+
+  function renderStatus(s) {
+    $('fw').textContent = s.firmware;
+    var pairs = [
+      ['Device ID', s.device_id],
+      ['Firmware', s.firmware + ' (Remote Management)'],
+      ['WiFi SSID', s.ssid],
+      ['IP Address', s.ip],
+      ['RSSI', s.rssi + ' dBm'],
+      ['Uptime', s.uptime_s + ' sec'],
+      s.time ? ['Ora (UTC)', s.time] : ['Ora', 'Non sincronizzata'],
+      ['WiFi Backup', s.wifi_backup ? 'Available' : 'None']
+    ];
+    if (s.last_command) {
+      pairs.push(['Last Command', s.last_command.type + ' (' + s.last_command.status + ')']);
+    }
+    $('status').innerHTML = rows(pairs);
+  }
+
+  function renderConfig(c) {
+    $('device').textContent = c.device_id;
+    $('version').textContent = c.config_version;
+    var html = '';
+
+    c.sensors.forEach(function (s) {
+      html += card('Sensore ' + s.slot, [
+        ['Pin GPIO:', s.pin], ['Tipo:', SENSOR_TYPES[s.type] || 'Sconosciuto'], ['Nome:', s.name]
+      ]).replace(/<\/div>$/, '<div id="history-' + s.slot + '"></div></div>');
+    });
+    if (!c.sensors.length) {
+      html += '<div class="card empty"><p>Nessun sensore configurato</p><p>Configura i sensori dalla dashboard web</p></div>';
+    }
+
+    c.actuators.forEach(function (a) {
+      var pairs = [['Pin GPIO:', a.pin],
+        ['Uscita:', a.output + '%' + (a.manual ? ' (manuale)' : '') + (a.tripped ? ' (blocco sicurezza)' : '')]];
+      if (a.remaining_s > 0) pairs.push(['Spegnimento tra:', a.remaining_s + ' s']);
+      html += card('Attuatore: ' + a.actuator_id, pairs);
+    });
+
+    c.loops.forEach(function (l) {
+      html += card('Controllo: ' + l.actuator_id, [
+        ['Modo:', (l.mode === 'pid' ? 'PID' : 'Isteresi') + (l.cooling ? ' (raffreddamento)' : ' (riscaldamento)')],
+        ['Sensore:', l.sensor], ['Setpoint:', l.setpoint.toFixed(1)], ['Uscita:', Math.round(l.output) + '%']
+      ]);
+    });
+
+    c.rules.forEach(function (r, i) {
+      html += card('Regola ' + (i + 1) + ': ' + r.actuator_id, [
+        ['Azione:', r.value + '%' + (r.duration_s > 0 ? ' per ' + r.duration_s + ' s' : '')],
+        ['Stato:', r.active ? 'attiva' : 'inattiva']
+      ]);
+    });
+
+    c.schedules.forEach(function (s, i) {
+      var days = WEEKDAYS.filter(function (d, n) { return s.weekdays & (1 << n); }).join(' ');
+      html += card('Timer ' + (i + 1) + ': ' + s.actuator_id, [
+        ['Avvio:', hms(s.start_s) + ' (' + days + ')'],
+        ['Durata:', s.duration_s + ' s al ' + s.value + '%'],
+        ['Stato:', s.running ? 'in esecuzione' : (c.time_synced ? 'in attesa' : "in attesa dell'ora (SNTP)")]
+      ]);
+    });
+
+    $('items').innerHTML = html;
+    c.sensors.forEach(function (s) {
+      get('/api/history?sensor=' + encodeURIComponent(s.name) + '&step=900', function (h) {
+        renderHistory($('history-' + s.slot), h);
+      });
+    });
+  }
+
+  // Last 24 h from flash: min/max and a line of the 15 min averages
+  function renderHistory(el, h) {
+    if (!h.points.length) return;
+    var lo = Math.min.apply(null, h.points.map(function (p) { return p[2]; }));
+    var hi = Math.max.apply(null, h.points.map(function (p) { return p[3]; }));
+    var range = (hi - lo) || 1;
+    var line = h.points.map(function (p) {
+      return ((p[0] - h.from) / (h.to - h.from) * 300).toFixed(1) + ',' + (38 - (p[1] - lo) / range * 36).toFixed(1);
+    }).join(' ');
+    el.innerHTML = '<p>Ultime 24 ore: min ' + lo + h.unit + ', max ' + hi + h.unit + '</p>' +
+      '<svg viewBox="0 0 300 40" class="spark"><polyline points="' + line + '"/></svg>';
+  }
+
+  // Live states are part of /api/status, /api/config only changes with config_version
+  function mergeLive(c, s) {
+    c.actuators.forEach(function (a, i) {
+      var live = s.actuators[i] || {};
+      a.output = live.output;
+      a.manual = live.manual;
+      a.tripped = live.tripped;
+      a.remaining_s = live.remaining_s;
+    });
+    c.loops.forEach(function (l, i) { l.output = s.loop_outputs[i] || 0; });
+    c.rules.forEach(function (r, i) { r.active = s.rules_active[i]; });
+    c.schedules.forEach(function (e, i) { e.running = s.schedules_running[i]; });
+    return c;
+  }
+
+  var page = document.body.getAttribute('data-page');
+  if (page === 'status') get('/api/status', renderStatus);
+  if (page === 'config') {
+    get('/api/config', function (c) {
+      get('/api/status', function (s) { renderConfig(mergeLive(c, s)); });
+    });
+  }
+})();
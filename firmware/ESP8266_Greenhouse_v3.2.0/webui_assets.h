@@ -0,0 +1,265 @@
+// Generated by firmware/tools/webui_assets.py from webui/ - do not edit
+#ifndef WEBUI_ASSETS_H
+#define WEBUI_ASSETS_H
+
+#include <Arduino.h>
+
+// Static web UI file, gzip-compressed in flash
+struct WebAsset {
+  const char* path;
+  const char* contentType;
+  const uint8_t* data;
+  size_t length;
+  bool immutable;       // Hashed URL: cache for a year
+  const char* etag;
+};
+
+// /style.4d9f0228.css: 973 bytes, 482 gzip
+static const uint8_t WEBUI_STYLE_CSS[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x65, 0x53, 0xed, 0x8e, 0xa3, 0x20,
+  0x14, 0xfd, 0x3f, 0x4f, 0x61, 0xd2, 0x4c, 0xb2, 0x9b, 0xd4, 0x06, 0xdb, 0xda, 0x51, 0xfa, 0x6b,
+  0x1e, 0x05, 0xe4, 0xa2, 0xa4, 0x14, 0x0c, 0xd0, 0xb1, 0xae, 0x99, 0x77, 0x5f, 0x10, 0xb5, 0x3a,
+  0x13, 0x63, 0x02, 0x5e, 0x38, 0x1f, 0xf7, 0x1e, 0xa9, 0x66, 0xfd, 0xc0, 0xb5, 0x72, 0x29, 0x27,
+  0x77, 0x21, 0x7b, 0xfc, 0x69, 0x04, 0x91, 0x7b, 0x4b, 0x94, 0x4d, 0x2d, 0x18, 0xc1, 0xaf, 0x77,
+  0xf2, 0x4c, 0x3b, 0xc1, 0x5c, 0x83, 0x0b, 0x84, 0xda, 0xa7, 0xdf, 0x9b, 0x5a, 0x28, 0x9c, 0xfb,
+  0x75, 0x42, 0x1e, 0x4e, 0x5f, 0x5b, 0xc2, 0x98, 0x50, 0x35, 0x3e, 0x86, 0x2a, 0x25, 0xd5, 0xad,
+  0x36, 0xfa, 0xa1, 0x18, 0xde, 0xf1, 0x3c, 0x3c, 0xdf, 0x6f, 0x4d, 0x36, 0x54, 0x5a, 0x6a, 0x83,
+  0x77, 0xc7, 0xea, 0x04, 0x39, 0xfa, 0x7e, 0x73, 0x84, 0x4a, 0x18, 0x22, 0x6a, 0x86, 0xd0, 0xfb,
+  0x95, 0x6a, 0xc3, 0xc0, 0xa4, 0xfe, 0x98, 0x24, 0xad, 0x05, 0x3c, 0x2f, 0xd6, 0x78, 0x5d, 0x23,
+  0x1c, 0xf8, 0xbb, 0x6c, 0xef, 0x9a, 0x61, 0x26, 0xcd, 0x8e, 0x9e, 0xd4, 0xc1, 0xd3, 0xa5, 0x44,
+  0x8a, 0x5a, 0x61, 0x09, 0xdc, 0xcd, 0x68, 0x54, 0x3b, 0xa7, 0xef, 0x38, 0xf3, 0x42, 0xad, 0x96,
+  0x82, 0x25, 0x3b, 0xc6, 0x98, 0x07, 0x68, 0x86, 0xb5, 0xca, 0xd3, 0xb9, 0x2c, 0x18, 0xbd, 0x46,
+  0x85, 0x13, 0xc7, 0x81, 0x3a, 0x35, 0x30, 0x61, 0x5b, 0x49, 0x7a, 0x2c, 0x94, 0x14, 0x0a, 0x52,
+  0x2a, 0x75, 0x75, 0x5b, 0xcc, 0x66, 0xc1, 0xfe, 0x2f, 0xc7, 0xbf, 0xb1, 0xa2, 0x36, 0x06, 0x95,
+  0x36, 0xc4, 0x09, 0xad, 0xb0, 0xd2, 0x0a, 0x66, 0x81, 0x86, 0x30, 0xf1, 0xb0, 0x38, 0x7f, 0x75,
+  0x75, 0x84, 0xf5, 0xfb, 0x28, 0x01, 0x37, 0xfa, 0x0b, 0xcc, 0x46, 0xed, 0xb1, 0x2c, 0x10, 0x2d,
+  0x7d, 0x59, 0x41, 0xb7, 0x2d, 0x7c, 0x10, 0xb8, 0xa0, 0x0d, 0xf5, 0x32, 0x18, 0x8f, 0x59, 0x04,
+  0xa5, 0x1b, 0xd6, 0x93, 0xff, 0x32, 0x0e, 0xde, 0x8a, 0x7f, 0x10, 0xfb, 0x18, 0x45, 0xa4, 0xa1,
+  0x87, 0x38, 0x8a, 0xa8, 0x88, 0x61, 0xc3, 0xcf, 0x19, 0x6c, 0x27, 0x3e, 0x2b, 0xf7, 0x17, 0x12,
+  0xf4, 0x83, 0x23, 0xb2, 0x3e, 0x53, 0xdb, 0x10, 0xa6, 0x3b, 0x8c, 0x92, 0x20, 0xe5, 0xec, 0x5f,
+  0x53, 0x53, 0xf2, 0x07, 0xed, 0xc7, 0xe7, 0x90, 0xfd, 0x9d, 0x98, 0x92, 0x98, 0x8b, 0x15, 0x9f,
+  0x33, 0x3e, 0x88, 0x2d, 0x31, 0xa0, 0xdc, 0x72, 0x86, 0x2d, 0xc3, 0xbf, 0x78, 0xa4, 0x20, 0xdc,
+  0x97, 0x84, 0xe2, 0x7a, 0xd3, 0x0f, 0x28, 0x78, 0x0e, 0xe5, 0x6b, 0x5e, 0xf9, 0xab, 0x01, 0xa3,
+  0xbf, 0xf3, 0x2b, 0x15, 0x53, 0xeb, 0x26, 0x23, 0xc1, 0x54, 0xe2, 0x33, 0x7a, 0xe8, 0x88, 0x51,
+  0x1b, 0x48, 0xce, 0xf9, 0xa9, 0x62, 0x6b, 0x94, 0x74, 0xca, 0x35, 0xe7, 0x55, 0x86, 0x3e, 0xfc,
+  0x1d, 0xb8, 0xb7, 0xae, 0x1f, 0x56, 0x79, 0xac, 0xbc, 0x72, 0x30, 0xd3, 0x58, 0x76, 0x65, 0x19,
+  0x46, 0x17, 0x0c, 0xdd, 0xd6, 0xe9, 0x6f, 0x40, 0xd4, 0x8d, 0xc3, 0x17, 0x34, 0x5a, 0x19, 0xcb,
+  0x49, 0xab, 0x65, 0x1f, 0x72, 0x37, 0x70, 0x21, 0x65, 0x4c, 0x8d, 0x75, 0x46, 0xdf, 0x60, 0x49,
+  0x59, 0xdc, 0x4e, 0xff, 0x66, 0x76, 0xf0, 0x3f, 0xda, 0x7f, 0x61, 0xa4, 0x2c, 0x73, 0xcd, 0x03,
+  0x00, 0x00,
+};
+
+// /app.62e73f41.js: 5534 bytes, 2241 gzip
+static const uint8_t WEBUI_APP_JS[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x58, 0x6d, 0x53, 0x1b, 0x39,
+  0x12, 0xfe, 0x9e, 0x5f, 0xa1, 0xe3, 0xb2, 0x99, 0x99, 0x5d, 0x67, 0x6c, 0x20, 0x97, 0xba, 0xc3,
+  0x36, 0x5b, 0x04, 0x48, 0xc2, 0x2d, 0x10, 0x0a, 0xc3, 0xe5, 0xb6, 0x38, 0x97, 0x4b, 0x9e, 0x91,
+  0x6d, 0x6d, 0xe4, 0xd1, 0x9c, 0xa4, 0x31, 0x38, 0x59, 0xfe, 0xfb, 0xb6, 0x5a, 0x9a, 0x37, 0x6c,
+  0xb2, 0xb5, 0xa9, 0x0a, 0x9e, 0x51, 0xb7, 0x5a, 0xad, 0xd6, 0xd3, 0xdd, 0x8f, 0xa6, 0xdb, 0x25,
+  0x23, 0x43, 0x0d, 0x4f, 0xc8, 0xed, 0xd9, 0x01, 0xc9, 0xe9, 0x9c, 0x69, 0x42, 0x15, 0x23, 0x09,
+  0x4d, 0x16, 0x2c, 0x25, 0xd3, 0x35, 0x31, 0x0b, 0x46, 0xa6, 0x4a, 0xde, 0x6b, 0xa6, 0x3a, 0x64,
+  0x45, 0x45, 0x01, 0x1a, 0x89, 0x5c, 0x32, 0x32, 0x53, 0x72, 0x49, 0xba, 0x34, 0xe7, 0xdd, 0x1f,
+  0x5f, 0x84, 0xb3, 0x22, 0x4b, 0x0c, 0x97, 0x19, 0x09, 0x23, 0xf2, 0xed, 0x05, 0x01, 0x45, 0x45,
+  0x46, 0xa7, 0x97, 0xa3, 0x4f, 0xd7, 0x93, 0x9b, 0x5f, 0xaf, 0x4e, 0x47, 0x64, 0x48, 0xbe, 0xed,
+  0x1e, 0x90, 0xe0, 0xe4, 0xe3, 0xcd, 0xde, 0x5e, 0xd0, 0x21, 0x7b, 0xee, 0x79, 0x77, 0x17, 0x9e,
+  0xf7, 0xe1, 0x79, 0x24, 0xb9, 0x20, 0x17, 0x92, 0x6b, 0x53, 0x28, 0x06, 0x63, 0x6f, 0x60, 0xec,
+  0x33, 0x35, 0x4c, 0x91, 0x73, 0xb6, 0x62, 0x22, 0x78, 0xec, 0x7b, 0xa3, 0x9f, 0x4f, 0x4f, 0x7f,
+  0x39, 0x39, 0xfa, 0xd5, 0x1a, 0xbc, 0x0b, 0x4e, 0xe4, 0x12, 0x74, 0x83, 0xf3, 0x22, 0xb3, 0x3f,
+  0x17, 0x54, 0xe1, 0x0f, 0xc3, 0x9f, 0x0f, 0x5c, 0xda, 0x9f, 0xff, 0x30, 0x94, 0x8d, 0xe8, 0x34,
+  0x18, 0xf7, 0x5f, 0x80, 0x91, 0xca, 0xd3, 0x97, 0x21, 0x4f, 0xc1, 0x59, 0xa2, 0x18, 0xac, 0x99,
+  0x91, 0x54, 0x26, 0xc5, 0x92, 0x65, 0x26, 0x9e, 0x33, 0x73, 0x2a, 0x98, 0x7d, 0x7c, 0xb7, 0x3e,
+  0x4b, 0xad, 0x52, 0x9f, 0x3c, 0xb6, 0x66, 0x32, 0x9d, 0x84, 0x18, 0x09, 0xb7, 0x57, 0x52, 0x9a,
+  0x18, 0x19, 0xc5, 0xb3, 0xb9, 0x17, 0xc5, 0x8a, 0xe5, 0x82, 0x26, 0x2c, 0xec, 0xde, 0xbd, 0x1a,
+  0x1c, 0x06, 0x3b, 0xe3, 0xee, 0xbc, 0x53, 0x9b, 0x08, 0x93, 0x72, 0x6e, 0x35, 0x3b, 0x78, 0xf5,
+  0xf7, 0x80, 0xfc, 0x44, 0x92, 0x38, 0x59, 0x50, 0x75, 0x2c, 0x53, 0x76, 0x64, 0xc2, 0x5e, 0x04,
+  0x23, 0x41, 0x3f, 0xe8, 0xa3, 0xea, 0x63, 0x64, 0x7f, 0xdb, 0xbe, 0xd8, 0x93, 0x09, 0x73, 0xca,
+  0x95, 0x7e, 0xe2, 0x0c, 0x8e, 0xc5, 0x4b, 0x9a, 0x37, 0xce, 0x26, 0xdf, 0x5c, 0x74, 0x60, 0xd4,
+  0xe1, 0xc0, 0xa4, 0x87, 0x03, 0x6d, 0x94, 0xcc, 0xe6, 0x87, 0xd6, 0x05, 0xbb, 0xbf, 0xfc, 0xae,
+  0x37, 0xc6, 0xc5, 0x07, 0x5d, 0x2f, 0x19, 0x74, 0xad, 0x1a, 0xfc, 0xaf, 0x55, 0x76, 0x4b, 0x15,
+  0x2b, 0xe9, 0x82, 0xa5, 0xca, 0xd1, 0xf8, 0x37, 0xc9, 0xb3, 0x30, 0x08, 0xb6, 0x78, 0x9c, 0x50,
+  0x95, 0x86, 0x86, 0x1b, 0xc1, 0x3a, 0x64, 0x9b, 0xe3, 0xc1, 0x20, 0xe5, 0x2b, 0x92, 0x08, 0xaa,
+  0xf5, 0x70, 0xc7, 0x2a, 0xef, 0x1c, 0x0e, 0x16, 0xfb, 0xd5, 0xaa, 0x38, 0xd3, 0x2f, 0x0b, 0xc3,
+  0x03, 0x43, 0xa7, 0x82, 0xa1, 0xb4, 0x19, 0x0a, 0xe7, 0x15, 0x8a, 0x06, 0x5d, 0xb0, 0xe7, 0x3c,
+  0x6b, 0x3b, 0xb2, 0x58, 0xea, 0x50, 0xb3, 0x44, 0x66, 0x69, 0xe5, 0x42, 0x25, 0xcb, 0x69, 0x1a,
+  0x66, 0x0d, 0x74, 0x84, 0x19, 0x19, 0x90, 0xdd, 0x1e, 0xf9, 0x99, 0x04, 0xbd, 0x80, 0x00, 0x38,
+  0x03, 0xbb, 0x46, 0x66, 0x91, 0xd1, 0x8a, 0x79, 0x1a, 0x5e, 0x50, 0xb3, 0x88, 0x67, 0x42, 0x4a,
+  0x55, 0x1a, 0x27, 0x5d, 0xb2, 0xff, 0xb6, 0xd7, 0x8b, 0xd0, 0xab, 0x03, 0xeb, 0xe9, 0xb3, 0x7a,
+  0x6f, 0xe1, 0xc0, 0x7f, 0xc0, 0xbf, 0x4d, 0xd5, 0x52, 0x8e, 0x92, 0xcd, 0x7d, 0x00, 0x60, 0xc3,
+  0x42, 0x89, 0x0e, 0x40, 0x38, 0xab, 0x20, 0x69, 0x73, 0xe5, 0x61, 0xa1, 0x20, 0x4d, 0x32, 0x76,
+  0x4f, 0xfe, 0x7b, 0x71, 0xfe, 0xd1, 0x98, 0xfc, 0x9a, 0xfd, 0x1f, 0xd2, 0xd7, 0x84, 0x91, 0x3b,
+  0x26, 0x90, 0xc7, 0x32, 0x13, 0x92, 0xa6, 0xa0, 0xf6, 0x34, 0x83, 0xed, 0x3f, 0x3e, 0x23, 0xa1,
+  0x55, 0xd2, 0x50, 0x22, 0x0a, 0x4d, 0x86, 0xc3, 0x21, 0xd9, 0x83, 0x8d, 0xe0, 0x42, 0xe1, 0xbf,
+  0x47, 0x9f, 0x2e, 0xe3, 0x9c, 0x2a, 0xcd, 0x50, 0x47, 0x31, 0x9d, 0xcb, 0x4c, 0xb3, 0x1b, 0xf6,
+  0x60, 0x22, 0xbf, 0xc0, 0x63, 0x63, 0x9d, 0x9c, 0x01, 0x1e, 0x3e, 0x9c, 0xde, 0x40, 0x36, 0x82,
+  0xb3, 0x0d, 0x0f, 0x34, 0xcb, 0xd2, 0x70, 0x1b, 0xb2, 0x61, 0x9c, 0xa9, 0x11, 0x2e, 0x1d, 0x56,
+  0x27, 0xf4, 0x32, 0x0c, 0x66, 0xf7, 0x41, 0x14, 0x1b, 0x58, 0xe6, 0x58, 0x66, 0x06, 0xd2, 0x14,
+  0x9c, 0xd7, 0xf1, 0x8c, 0xab, 0xe5, 0x3d, 0x54, 0xae, 0x7e, 0xb5, 0x7b, 0x44, 0x82, 0x2d, 0x13,
+  0x7e, 0x33, 0x50, 0x2e, 0xd8, 0x8a, 0x27, 0x8c, 0x9c, 0x9d, 0x80, 0x0f, 0x3a, 0x4e, 0xf1, 0x6d,
+  0xc2, 0xd3, 0x71, 0xa7, 0xd2, 0x78, 0xef, 0xad, 0xa0, 0x42, 0x69, 0xd2, 0x9e, 0x05, 0x09, 0xaf,
+  0xd9, 0x52, 0x1a, 0x46, 0x2e, 0x68, 0x06, 0x45, 0xd2, 0x56, 0x87, 0x28, 0x68, 0x4c, 0xfc, 0xcc,
+  0xdf, 0x73, 0x32, 0x1a, 0x79, 0xd3, 0x5a, 0xb7, 0xac, 0x9e, 0x5d, 0x91, 0xa3, 0x34, 0x85, 0x00,
+  0x69, 0x94, 0xf2, 0xbc, 0x21, 0xbb, 0x86, 0x49, 0x38, 0xaa, 0x60, 0x12, 0xae, 0x94, 0xbe, 0x5b,
+  0x36, 0x2d, 0xdf, 0xe6, 0x86, 0x2f, 0x9d, 0x43, 0x05, 0x3e, 0x4e, 0x34, 0xaa, 0x01, 0x28, 0x6a,
+  0x35, 0x1d, 0x5b, 0x09, 0xa0, 0xf3, 0x2e, 0xf8, 0xa4, 0x28, 0x09, 0x6f, 0x6f, 0x8e, 0x23, 0x9c,
+  0x62, 0x87, 0xc7, 0x80, 0x57, 0x1c, 0xb7, 0x85, 0xf0, 0x12, 0x22, 0xab, 0x79, 0x96, 0x40, 0x4a,
+  0xf3, 0xaf, 0x5f, 0xa9, 0xa1, 0x1b, 0xbb, 0x78, 0x47, 0x93, 0x2f, 0x45, 0x8e, 0xb3, 0xef, 0xf9,
+  0x8c, 0x4f, 0xa6, 0xf8, 0x6e, 0x91, 0x7f, 0xb4, 0xa2, 0x5c, 0xd8, 0x9c, 0xc2, 0x0c, 0x00, 0x4b,
+  0x2c, 0x18, 0xe3, 0xdc, 0xb1, 0x8b, 0xba, 0x85, 0x8b, 0x8e, 0x21, 0x71, 0xcd, 0x04, 0x3a, 0xc4,
+  0x92, 0x66, 0x69, 0x0d, 0x25, 0x57, 0x8e, 0xf2, 0x42, 0x2f, 0xc2, 0xbb, 0xe0, 0x1c, 0x54, 0xc8,
+  0xb1, 0x53, 0xc1, 0x85, 0x9a, 0x73, 0x62, 0xb3, 0xce, 0x7d, 0xcc, 0x6d, 0x02, 0x3c, 0x11, 0x7a,
+  0x28, 0x82, 0x18, 0xe2, 0x5f, 0xc2, 0xac, 0x44, 0x86, 0x13, 0x02, 0x3a, 0x78, 0x96, 0x31, 0xf5,
+  0xf1, 0xe6, 0xe2, 0x1c, 0xce, 0xbf, 0x51, 0x16, 0x9e, 0x03, 0x19, 0x00, 0x69, 0xc6, 0xe7, 0x75,
+  0x4d, 0x06, 0x53, 0x0e, 0x1d, 0x1b, 0x40, 0x4b, 0x6a, 0xd8, 0xf4, 0x4b, 0xd5, 0x15, 0x53, 0x1a,
+  0x6c, 0x6d, 0xd1, 0x4d, 0xd0, 0xee, 0xc4, 0x2b, 0xd4, 0xd0, 0x5c, 0x98, 0xa5, 0x00, 0x85, 0x20,
+  0xc0, 0x8e, 0x44, 0x40, 0x13, 0x92, 0x40, 0x4b, 0x08, 0xd0, 0x4c, 0xaa, 0x53, 0x68, 0xbd, 0x8d,
+  0x9a, 0xad, 0xeb, 0x18, 0xe2, 0xb4, 0x9f, 0x86, 0xae, 0x82, 0x06, 0x23, 0x9c, 0xc2, 0x88, 0x0b,
+  0x92, 0x16, 0xd2, 0x74, 0x2a, 0xac, 0xdb, 0xc3, 0xbc, 0xe2, 0x19, 0xf9, 0x70, 0x75, 0xf6, 0xe9,
+  0x00, 0x23, 0x9c, 0xf3, 0x6c, 0x0c, 0xf2, 0xe0, 0x86, 0xe7, 0xd2, 0x8e, 0x34, 0x9b, 0xf3, 0x9d,
+  0xc6, 0x98, 0x8f, 0xc9, 0xef, 0xbf, 0x43, 0xa7, 0x04, 0xa7, 0xa5, 0x4e, 0x78, 0x61, 0x64, 0x80,
+  0x33, 0x2e, 0xa1, 0xd9, 0x3b, 0x1b, 0x19, 0x05, 0x30, 0xf9, 0x15, 0xc6, 0x8d, 0x06, 0x37, 0xf8,
+  0x1f, 0x96, 0xd8, 0x97, 0xdd, 0x8e, 0x2f, 0xde, 0x3c, 0x1d, 0xee, 0x2c, 0xa0, 0x97, 0x4b, 0xb5,
+  0x7e, 0x5d, 0xbb, 0x67, 0x0f, 0x6d, 0xc7, 0x97, 0x63, 0x5f, 0x94, 0xa3, 0x66, 0x63, 0x73, 0x00,
+  0xfa, 0x5b, 0x1d, 0x0c, 0xc1, 0xb2, 0xb9, 0x59, 0x6c, 0xee, 0x7f, 0xa3, 0x43, 0x10, 0xb6, 0xcc,
+  0xcd, 0x1a, 0x6c, 0xe7, 0x87, 0x97, 0x90, 0x65, 0x05, 0x40, 0xdc, 0x07, 0xc7, 0x9d, 0x40, 0xa1,
+  0xa8, 0x91, 0x83, 0x6e, 0x6e, 0x15, 0x8e, 0xcb, 0x11, 0xc2, 0xbd, 0x16, 0x27, 0x29, 0x15, 0x82,
+  0xc2, 0x5f, 0xbd, 0x98, 0x4a, 0x6b, 0xee, 0x9e, 0x4d, 0x51, 0xbb, 0xee, 0x1c, 0x1e, 0x37, 0xf6,
+  0xa8, 0x68, 0x62, 0x0a, 0x30, 0xb7, 0xf5, 0xb0, 0x68, 0xed, 0x6c, 0xab, 0x04, 0xb5, 0x4f, 0x83,
+  0xba, 0xd3, 0x68, 0x9c, 0xd5, 0x2d, 0x04, 0xdc, 0x50, 0x27, 0x93, 0x85, 0xc9, 0x0b, 0x0c, 0xd6,
+  0x0f, 0x36, 0x76, 0x21, 0x85, 0x26, 0x9e, 0x15, 0x54, 0xd8, 0x0c, 0x24, 0xa1, 0x7b, 0x66, 0x51,
+  0xdd, 0x84, 0x40, 0x01, 0x78, 0x47, 0x9e, 0x03, 0x5d, 0x43, 0x8d, 0xa9, 0x90, 0x49, 0x22, 0x21,
+  0xc9, 0x13, 0xa0, 0x52, 0x90, 0xe2, 0xa5, 0xea, 0xd8, 0x67, 0xa9, 0x0b, 0x33, 0x85, 0xe3, 0x5b,
+  0x52, 0x9e, 0x01, 0x61, 0x81, 0x82, 0x72, 0x48, 0xa0, 0xaa, 0xb7, 0x52, 0x74, 0x94, 0xb3, 0x79,
+  0xc6, 0x6d, 0x9d, 0x93, 0xc4, 0x28, 0xef, 0x5a, 0x73, 0x0a, 0xd6, 0xa0, 0x2a, 0x05, 0x9f, 0x82,
+  0xf3, 0xc8, 0xb8, 0x20, 0xb1, 0x03, 0xc4, 0x27, 0xad, 0xa2, 0x06, 0x89, 0x53, 0xb6, 0xfd, 0xfa,
+  0xec, 0x7d, 0x64, 0xa1, 0x19, 0xe6, 0xdb, 0xa2, 0x2a, 0x9e, 0x4b, 0x01, 0x9b, 0x6b, 0x4a, 0x0a,
+  0x21, 0xdd, 0x2a, 0xa2, 0xbd, 0x4a, 0x33, 0x19, 0x2e, 0x64, 0x8a, 0xb0, 0x0f, 0x45, 0xbc, 0x04,
+  0x6a, 0x85, 0xad, 0x2c, 0xc8, 0x79, 0x1a, 0xd8, 0x98, 0x5d, 0x41, 0xd9, 0xb6, 0x31, 0x3a, 0xd3,
+  0x40, 0x38, 0x99, 0xe6, 0x2e, 0xac, 0x02, 0xd2, 0x57, 0x0a, 0xd8, 0xac, 0x0b, 0xab, 0xa2, 0xb3,
+  0x99, 0x62, 0x69, 0x4a, 0x31, 0x26, 0x2e, 0xa8, 0x30, 0xca, 0x75, 0x42, 0x45, 0x35, 0x18, 0xb5,
+  0x4e, 0xd5, 0x67, 0xa8, 0x5d, 0x57, 0x78, 0x50, 0x63, 0x46, 0x8d, 0x98, 0xc9, 0x81, 0x1e, 0x99,
+  0x52, 0xe0, 0xde, 0x62, 0x23, 0xdf, 0xf3, 0x07, 0x96, 0x86, 0xbb, 0x11, 0x6a, 0xd5, 0x98, 0x40,
+  0xaa, 0xa0, 0x64, 0x01, 0x7d, 0x52, 0x78, 0x78, 0x44, 0x0e, 0x1f, 0x75, 0x36, 0x6e, 0x04, 0x53,
+  0x15, 0x82, 0x6d, 0x0b, 0x26, 0xb0, 0x78, 0xfe, 0x5c, 0x3c, 0xaf, 0xd9, 0x5c, 0x42, 0x22, 0x20,
+  0xec, 0x6c, 0x33, 0xda, 0x75, 0x3c, 0x04, 0x07, 0xd4, 0xf3, 0xc1, 0x3d, 0xfa, 0x0a, 0x96, 0x71,
+  0x9b, 0x2a, 0x46, 0xf2, 0x5b, 0x83, 0x57, 0xc5, 0xa9, 0x4d, 0x3e, 0x90, 0x3b, 0x94, 0x61, 0x2c,
+  0x73, 0xa0, 0xf5, 0xce, 0x64, 0x43, 0xe8, 0xf0, 0xe4, 0xa1, 0xda, 0x8a, 0x22, 0x14, 0x75, 0xe9,
+  0x8c, 0x83, 0x07, 0x7c, 0x65, 0xdb, 0x5c, 0x40, 0x0d, 0x3c, 0x51, 0x54, 0xe7, 0x99, 0x7f, 0xf9,
+  0x4e, 0x30, 0xb4, 0xbd, 0xcd, 0x3c, 0x13, 0x10, 0xdd, 0x0a, 0x88, 0x4d, 0xdb, 0x94, 0xae, 0x6d,
+  0xd6, 0x96, 0x57, 0x0d, 0x20, 0x02, 0x02, 0x80, 0xd1, 0x98, 0x02, 0xfb, 0x6f, 0x92, 0x43, 0x68,
+  0x94, 0x8c, 0x7d, 0xc1, 0x59, 0xaf, 0x48, 0xb8, 0x4b, 0x06, 0x03, 0x10, 0xf7, 0x6b, 0x16, 0x4c,
+  0x82, 0x67, 0xb2, 0xe4, 0x06, 0x12, 0x4c, 0x6d, 0x0f, 0xb7, 0xfe, 0x4e, 0xb8, 0x57, 0x2b, 0x8e,
+  0x01, 0x41, 0x02, 0x6b, 0x3b, 0xa2, 0x32, 0x13, 0xc7, 0x79, 0x5d, 0xcb, 0x44, 0x4f, 0x5c, 0x87,
+  0x6c, 0x06, 0xf2, 0xc4, 0x06, 0x9b, 0xba, 0x52, 0xfe, 0x34, 0xf0, 0x04, 0xea, 0x8b, 0x5b, 0xb6,
+  0x71, 0x80, 0xdb, 0x8f, 0x01, 0xa8, 0x4a, 0x91, 0x65, 0x3e, 0x2f, 0xb8, 0xbd, 0x0d, 0xb1, 0xa4,
+  0x40, 0x04, 0xd8, 0xe3, 0x08, 0x93, 0xd8, 0x91, 0x94, 0x75, 0x96, 0xb8, 0x8a, 0x04, 0x2a, 0x70,
+  0x40, 0x4c, 0xe3, 0x69, 0xed, 0x54, 0x6f, 0x24, 0x65, 0x42, 0x04, 0xd2, 0xb2, 0x95, 0xd1, 0xe5,
+  0xcd, 0x55, 0xb4, 0x13, 0x3d, 0x7b, 0x7e, 0xd0, 0x63, 0xb9, 0x61, 0xcb, 0xa7, 0x8d, 0xdd, 0xc6,
+  0xb2, 0xff, 0x57, 0xfa, 0xa7, 0x25, 0xca, 0x01, 0xde, 0x58, 0x7d, 0x73, 0xfa, 0xd9, 0x4d, 0x1b,
+  0xe2, 0xdd, 0x22, 0x4b, 0xa0, 0x30, 0xdc, 0x5e, 0x9f, 0x01, 0x2f, 0x01, 0x22, 0x0b, 0xf9, 0x1c,
+  0xba, 0x8e, 0x87, 0x81, 0x7d, 0x05, 0xa5, 0x21, 0x1f, 0xfe, 0xab, 0xd7, 0x0b, 0x9a, 0x97, 0xb8,
+  0x46, 0x6f, 0x22, 0x9e, 0x4a, 0x7c, 0x74, 0x96, 0x43, 0xf0, 0x79, 0xb3, 0x03, 0x46, 0x70, 0x66,
+  0x15, 0x14, 0x1e, 0xa3, 0x8d, 0x5b, 0x5d, 0xb7, 0x4b, 0x90, 0x1a, 0xed, 0xbd, 0x21, 0x0b, 0x77,
+  0xbf, 0x9e, 0x41, 0x93, 0x5b, 0x1c, 0x90, 0x25, 0xcf, 0xba, 0x4b, 0xfa, 0x40, 0x80, 0x01, 0x11,
+  0x4a, 0xa0, 0x28, 0x31, 0x22, 0x67, 0x78, 0x35, 0xdf, 0xfd, 0x87, 0x15, 0x12, 0x0a, 0x1c, 0xc3,
+  0x5e, 0xde, 0x37, 0xb9, 0x4d, 0xe9, 0x10, 0x13, 0x76, 0x71, 0xef, 0x2f, 0x36, 0xda, 0x45, 0x8c,
+  0x75, 0xa7, 0xee, 0xb3, 0x0e, 0xce, 0x35, 0x4d, 0x11, 0x12, 0xa2, 0x8c, 0xc5, 0x07, 0x96, 0x88,
+  0x69, 0x9e, 0x8b, 0x75, 0x98, 0x15, 0xc2, 0x1a, 0x2a, 0xa7, 0x6e, 0xde, 0x2f, 0xab, 0xbb, 0xd0,
+  0xdd, 0xde, 0xd8, 0xe6, 0x40, 0xd4, 0xa0, 0x3d, 0xbc, 0xb2, 0x47, 0x1f, 0xfe, 0xba, 0xbd, 0xfd,
+  0xa7, 0xf6, 0x14, 0xcd, 0xe6, 0x50, 0xca, 0xe1, 0x1c, 0x38, 0x79, 0x0d, 0xde, 0x46, 0x96, 0xc0,
+  0xec, 0x36, 0xfc, 0xb7, 0x71, 0x1a, 0x7e, 0xcf, 0x78, 0xfb, 0x32, 0x1c, 0xe2, 0xad, 0x17, 0x4c,
+  0xc1, 0xc5, 0x0c, 0x82, 0x1f, 0xc1, 0x85, 0x2c, 0x5c, 0x40, 0x59, 0x6e, 0x8c, 0xfc, 0x48, 0xf6,
+  0xe1, 0x02, 0xd4, 0x28, 0xd5, 0x16, 0x1c, 0x1d, 0xcc, 0xe0, 0xfd, 0x7f, 0x82, 0x1e, 0x5e, 0x8a,
+  0xbd, 0x33, 0x5d, 0xef, 0x20, 0xcc, 0x79, 0xdb, 0x9c, 0xf2, 0xe4, 0x8e, 0x5c, 0x55, 0x07, 0x26,
+  0x5a, 0xf0, 0x0e, 0x80, 0xac, 0xdc, 0x0a, 0xe4, 0xf5, 0x80, 0x07, 0x6c, 0xa5, 0xf6, 0xa4, 0xb1,
+  0xd1, 0x49, 0xf8, 0xb3, 0x88, 0x8b, 0x8c, 0x23, 0x4f, 0xe8, 0x10, 0x8b, 0x0d, 0x2b, 0x58, 0xf0,
+  0x96, 0xc0, 0x92, 0x18, 0x18, 0xf6, 0xbb, 0x0c, 0x06, 0x7a, 0x35, 0x27, 0x2b, 0xce, 0xee, 0xdf,
+  0xc9, 0x87, 0xe1, 0x4e, 0x0f, 0xaa, 0x31, 0x6c, 0x86, 0xbc, 0xe9, 0xed, 0x94, 0x5c, 0x4a, 0xc3,
+  0x75, 0xee, 0x8b, 0xa5, 0x51, 0x52, 0xac, 0x31, 0x78, 0x2e, 0x70, 0xc3, 0x1d, 0x5c, 0xd4, 0x0e,
+  0x58, 0x0a, 0xd7, 0x05, 0x62, 0x04, 0x96, 0x1a, 0x57, 0x6a, 0x8b, 0x5b, 0x5b, 0x98, 0x2d, 0xff,
+  0xf6, 0x1f, 0x90, 0xc0, 0x92, 0xb1, 0x18, 0xc5, 0x74, 0x73, 0xbc, 0xbc, 0xe3, 0x5e, 0x1c, 0x25,
+  0x23, 0x70, 0xf1, 0x5c, 0x93, 0x64, 0x61, 0x23, 0xa4, 0xc9, 0x3d, 0x37, 0x0b, 0xd2, 0x66, 0xcb,
+  0x4d, 0x24, 0x43, 0x95, 0x9c, 0x33, 0xbb, 0x42, 0x98, 0x40, 0xfd, 0x29, 0xcf, 0xed, 0x4f, 0xa8,
+  0xd8, 0x46, 0x59, 0x17, 0xd6, 0xc5, 0x61, 0xa3, 0xb2, 0xea, 0x3b, 0x8e, 0x9c, 0xf7, 0xdb, 0x63,
+  0x99, 0x93, 0x15, 0xfb, 0x1a, 0xa2, 0xb6, 0x7f, 0xab, 0xa5, 0x9e, 0x89, 0x79, 0xa9, 0x7b, 0xab,
+  0xa5, 0x25, 0x0d, 0xf3, 0x62, 0xff, 0x5a, 0xcb, 0x9b, 0xf4, 0xc9, 0xeb, 0x34, 0x86, 0xda, 0x54,
+  0xf8, 0x3b, 0x6c, 0xc8, 0x6d, 0x8c, 0x88, 0xda, 0x57, 0x8d, 0xca, 0x13, 0xf7, 0x5e, 0xee, 0xaa,
+  0xd7, 0x6f, 0x18, 0xfb, 0x13, 0x36, 0x50, 0xf7, 0xd6, 0x21, 0xd6, 0x77, 0x50, 0x9e, 0xb8, 0x01,
+  0x30, 0xd6, 0xb4, 0xf3, 0xbd, 0x46, 0xca, 0xbc, 0x2d, 0x56, 0x35, 0x08, 0x6b, 0xac, 0x9a, 0x31,
+  0xf1, 0xa3, 0x2d, 0x8b, 0x3e, 0xf3, 0x92, 0x0a, 0x4a, 0x8e, 0x36, 0x63, 0x5a, 0x57, 0x5f, 0xe4,
+  0xa6, 0x32, 0x5d, 0xdb, 0xcf, 0x72, 0x40, 0x2a, 0x15, 0x9f, 0x16, 0x86, 0xc1, 0xf5, 0x0c, 0x3a,
+  0xd9, 0x6b, 0xab, 0xe7, 0x92, 0xc7, 0xd6, 0x33, 0x37, 0xcb, 0xf2, 0xba, 0xf2, 0x1a, 0xd8, 0x28,
+  0xf8, 0x7e, 0xa8, 0xd3, 0xfa, 0xaa, 0xb0, 0x65, 0xaa, 0xc3, 0x60, 0x50, 0x02, 0xa7, 0x36, 0xe0,
+  0x05, 0xcf, 0x7c, 0xc2, 0xdb, 0xb2, 0x50, 0xbb, 0x03, 0xb5, 0x2f, 0x9a, 0x4f, 0xf0, 0x1c, 0xf5,
+  0x37, 0x9a, 0xc1, 0x63, 0x64, 0x3f, 0x89, 0xfc, 0x01, 0x9f, 0x7d, 0xab, 0xbe, 0x9e, 0x15, 0x00,
+  0x00,
+};
+
+// /: 580 bytes, 369 gzip
+static const uint8_t WEBUI_INDEX_HTML[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x55, 0x52, 0x4d, 0x4f, 0xc3, 0x30,
+  0x0c, 0xbd, 0xf3, 0x2b, 0x42, 0xce, 0xac, 0x65, 0x05, 0x8d, 0x21, 0x35, 0xbd, 0x8c, 0x71, 0x84,
+  0x49, 0xe3, 0x43, 0x1c, 0xdd, 0xc4, 0x5d, 0x03, 0x59, 0x5a, 0x25, 0x1e, 0x13, 0xff, 0x1e, 0x27,
+  0x5b, 0x91, 0x38, 0x44, 0x91, 0x9f, 0xed, 0xf7, 0x9e, 0x9d, 0xd4, 0x97, 0x0f, 0xcf, 0xab, 0x97,
+  0x8f, 0xcd, 0x5a, 0xf4, 0xb4, 0x77, 0xcd, 0x45, 0x9d, 0x2e, 0xe1, 0xc0, 0xef, 0x94, 0xb4, 0x24,
+  0x13, 0x80, 0x60, 0xf8, 0xda, 0x23, 0x81, 0xd0, 0x3d, 0x84, 0x88, 0xa4, 0xe4, 0xeb, 0xcb, 0xe3,
+  0x6c, 0x29, 0x27, 0xd8, 0xc3, 0x1e, 0x95, 0xfc, 0xb6, 0x78, 0x1c, 0x87, 0x40, 0x52, 0xe8, 0xc1,
+  0x13, 0x7a, 0x2e, 0x3b, 0x5a, 0x43, 0xbd, 0x32, 0xf8, 0x6d, 0x35, 0xce, 0x72, 0x70, 0x25, 0xac,
+  0xb7, 0x64, 0xc1, 0xcd, 0xa2, 0x06, 0x87, 0x6a, 0x9e, 0x48, 0xc8, 0x92, 0xc3, 0x66, 0x8b, 0x21,
+  0x80, 0x58, 0x6f, 0x37, 0xcb, 0x6a, 0xb1, 0xa8, 0xcb, 0x13, 0x78, 0x51, 0x3b, 0xeb, 0xbf, 0x44,
+  0x40, 0xa7, 0x64, 0xa4, 0x1f, 0x87, 0xb1, 0x47, 0x64, 0x89, 0x3e, 0x60, 0xa7, 0x64, 0x99, 0xa1,
+  0xe2, 0xd6, 0xdc, 0x77, 0xd7, 0x55, 0xb5, 0x2c, 0x74, 0x8c, 0x89, 0xaf, 0x3c, 0x7b, 0x6e, 0x07,
+  0xf3, 0x23, 0x0c, 0x10, 0xcc, 0x46, 0xd8, 0x61, 0x22, 0x00, 0x3a, 0xe4, 0x8a, 0x7e, 0xfe, 0x5f,
+  0x4e, 0xd4, 0x71, 0x04, 0x2f, 0xac, 0x51, 0xb2, 0x3b, 0xca, 0xa6, 0x2e, 0x53, 0xd8, 0x9c, 0x51,
+  0xed, 0x20, 0x46, 0x25, 0x3d, 0x72, 0xe6, 0x69, 0xfd, 0x7e, 0x4e, 0xb2, 0xca, 0x3c, 0x79, 0x87,
+  0x36, 0xdb, 0xa4, 0xac, 0x59, 0x53, 0xe0, 0xd3, 0x37, 0x1b, 0x08, 0xbc, 0x13, 0x0a, 0x03, 0xcf,
+  0xd1, 0x67, 0xe4, 0x0d, 0xdc, 0x10, 0xf0, 0x14, 0x96, 0xa9, 0xaa, 0xa4, 0xb3, 0x4b, 0xca, 0x36,
+  0x93, 0xf4, 0xe4, 0xef, 0xc4, 0x62, 0x78, 0x8f, 0x2e, 0x49, 0x29, 0x59, 0xc9, 0x66, 0x05, 0xc1,
+  0x6a, 0xe6, 0xf4, 0x34, 0x14, 0x45, 0xc1, 0xdd, 0xe6, 0x8f, 0x27, 0xf5, 0xa7, 0xa9, 0x27, 0x2b,
+  0x2d, 0xa3, 0x30, 0x6d, 0x88, 0xdf, 0xa2, 0xb3, 0x3b, 0x39, 0x0d, 0xd1, 0x92, 0x67, 0xae, 0x8c,
+  0x1d, 0x78, 0xfc, 0x2d, 0xfa, 0x38, 0x04, 0x5b, 0x97, 0xc0, 0x7d, 0x51, 0x07, 0x3b, 0x92, 0x88,
+  0x41, 0x73, 0x1f, 0x8c, 0x63, 0xb1, 0xa8, 0xf0, 0xee, 0xa6, 0xbb, 0x9d, 0x17, 0x9f, 0x31, 0xef,
+  0x24, 0xe7, 0x93, 0xd2, 0xa4, 0x78, 0xfa, 0x33, 0xbf, 0x37, 0xd0, 0xec, 0x44, 0x44, 0x02, 0x00,
+  0x00,
+};
+
+// /config: 703 bytes, 426 gzip
+static const uint8_t WEBUI_CONFIG_HTML[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x75, 0x52, 0x4d, 0x8f, 0xd3, 0x30,
+  0x10, 0xbd, 0xf7, 0x57, 0x0c, 0x3e, 0x81, 0xb4, 0x49, 0x68, 0x59, 0xc1, 0x82, 0x92, 0x48, 0xa8,
+  0x05, 0x69, 0x4f, 0xbb, 0xda, 0x5d, 0x90, 0x38, 0x4e, 0xec, 0x49, 0x63, 0x70, 0xec, 0xc8, 0x9e,
+  0xa6, 0x2a, 0xbf, 0x1e, 0xdb, 0x69, 0x59, 0x04, 0xe2, 0xe4, 0xe4, 0xf9, 0xcd, 0xfb, 0xc8, 0xa4,
+  0x7e, 0xb1, 0xbb, 0xdb, 0x3e, 0x7d, 0xbb, 0xff, 0x04, 0x03, 0x8f, 0xa6, 0x5d, 0xd5, 0xe9, 0x00,
+  0x83, 0x76, 0xdf, 0x08, 0xcd, 0x22, 0x01, 0x84, 0x2a, 0x1e, 0x23, 0x31, 0x82, 0x1c, 0xd0, 0x07,
+  0xe2, 0x46, 0x7c, 0x79, 0xfa, 0x5c, 0xdc, 0x88, 0x0b, 0x6c, 0x71, 0xa4, 0x46, 0xcc, 0x9a, 0x8e,
+  0x93, 0xf3, 0x2c, 0x40, 0x3a, 0xcb, 0x64, 0x23, 0xed, 0xa8, 0x15, 0x0f, 0x8d, 0xa2, 0x59, 0x4b,
+  0x2a, 0xf2, 0xcb, 0x15, 0x68, 0xab, 0x59, 0xa3, 0x29, 0x82, 0x44, 0x43, 0xcd, 0x3a, 0x89, 0xb0,
+  0x66, 0x43, 0xed, 0xd6, 0xd9, 0x5e, 0xef, 0x0f, 0x1e, 0x7f, 0x6a, 0x67, 0x09, 0x1e, 0xc9, 0x06,
+  0xe7, 0x75, 0x5d, 0x2d, 0xb7, 0xab, 0xda, 0x68, 0xfb, 0x03, 0x3c, 0x99, 0x46, 0x04, 0x3e, 0x19,
+  0x0a, 0x03, 0x51, 0xf4, 0x1a, 0x3c, 0xf5, 0x8d, 0xa8, 0x32, 0x54, 0x5e, 0xab, 0xf7, 0xfd, 0xeb,
+  0xcd, 0xe6, 0xa6, 0x94, 0x21, 0x24, 0xe1, 0xea, 0x1c, 0xbe, 0x73, 0xea, 0x04, 0x0a, 0x19, 0x8b,
+  0x09, 0xf7, 0x31, 0xaa, 0xcc, 0x56, 0xb9, 0xdd, 0xfa, 0x3f, 0xbe, 0xf0, 0xf2, 0x21, 0xce, 0x16,
+  0x77, 0xd6, 0x9c, 0x5e, 0x45, 0x9d, 0x75, 0xe4, 0x4e, 0xed, 0x2e, 0x37, 0x81, 0xdb, 0xdd, 0x07,
+  0xa8, 0x03, 0x7b, 0x67, 0xf7, 0xa0, 0x55, 0x23, 0x96, 0x82, 0xa2, 0xad, 0xab, 0x05, 0x8c, 0x0f,
+  0x53, 0xe4, 0x2b, 0x3d, 0x83, 0x34, 0x18, 0x42, 0xfc, 0x94, 0xb6, 0x77, 0x70, 0x44, 0x6f, 0x23,
+  0xe9, 0xcc, 0xf9, 0xcb, 0x76, 0x6b, 0xdc, 0x41, 0xc1, 0x47, 0x66, 0x3d, 0xe3, 0xb3, 0x4e, 0xe7,
+  0xdb, 0xd5, 0x2d, 0x84, 0x73, 0xa4, 0xe0, 0xac, 0x03, 0x79, 0x99, 0x63, 0x1d, 0x2b, 0x19, 0x83,
+  0x70, 0xa4, 0x0e, 0xa7, 0xa9, 0x84, 0x7b, 0xf2, 0x30, 0x3a, 0xa5, 0x7b, 0x2d, 0xd1, 0x53, 0x5c,
+  0xe2, 0x33, 0x37, 0x7b, 0x5c, 0xc1, 0x21, 0x60, 0x82, 0x15, 0x86, 0xa1, 0x73, 0xe8, 0x55, 0x1a,
+  0x2d, 0xeb, 0x2a, 0x06, 0xfd, 0x37, 0xae, 0x38, 0x27, 0x84, 0xaf, 0xe4, 0x43, 0x1c, 0x4f, 0x95,
+  0x27, 0xb4, 0xb9, 0xf0, 0xbc, 0x40, 0xb9, 0x71, 0xc4, 0xda, 0x3f, 0x25, 0xd2, 0xbd, 0x66, 0x1a,
+  0x83, 0xf8, 0x0d, 0xe3, 0x65, 0x4b, 0xe2, 0x62, 0xd0, 0x71, 0x1c, 0x7e, 0x64, 0x64, 0x57, 0x57,
+  0x18, 0x19, 0x41, 0x7a, 0x3d, 0x31, 0x04, 0x2f, 0x23, 0x2b, 0x95, 0x79, 0xbb, 0xa1, 0x77, 0x6f,
+  0xfa, 0xeb, 0x75, 0xf9, 0x3d, 0xeb, 0x2c, 0xf7, 0x69, 0xa3, 0x69, 0x95, 0x79, 0xb3, 0xf9, 0x77,
+  0xfd, 0x05, 0xf7, 0xb6, 0x55, 0xd1, 0xbf, 0x02, 0x00, 0x00,
+};
+
+static const WebAsset webAssets[] = {
+  {"/style.4d9f0228.css", "text/css", WEBUI_STYLE_CSS, sizeof(WEBUI_STYLE_CSS), true, "\"4d9f0228\""},
+  {"/app.62e73f41.js", "application/javascript", WEBUI_APP_JS, sizeof(WEBUI_APP_JS), true, "\"62e73f41\""},
+  {"/", "text/html", WEBUI_INDEX_HTML, sizeof(WEBUI_INDEX_HTML), false, "\"2ceeb0b1\""},
+  {"/config", "text/html", WEBUI_CONFIG_HTML, sizeof(WEBUI_CONFIG_HTML), false, "\"18b8be1e\""},
+};
+
+#define WEB_ASSET_COUNT (sizeof(webAssets) / sizeof(webAssets[0]))
+
+#endif
@@ -0,0 +1,21 @@
+// Globals of the host stubs (stubs/) and the test helpers
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <DHT.h>
+#include <ESP8266WiFi.h>
+#include "test.h"
+
+unsigned long hostMillis = 0;
+HostSerial Serial;
+HostEsp ESP;
+HostWiFi WiFi;
+float hostDhtTemperature = NAN;
+float hostDhtHumidity = NAN;
+int hostDhtReads = 0;
+char hostLastSerialized[32];
+int testFailures = 0;
+
+int testSummary(const char* name) {
+  printf("%s: %s\n", name, testFailures ? "FAILED" : "OK");
+  return testFailures ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+// Host build of firmware modules: just enough of the Arduino core
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+using std::isnan;
+
+// millis() is driven by the test
+extern unsigned long hostMillis;
+inline unsigned long millis() { return hostMillis; }
+inline unsigned long micros() { return hostMillis * 1000; }
+inline void yield() {}
+
+template <typename T> T min(T a, T b) { return a < b ? a : b; }
+template <typename T> T max(T a, T b) { return a > b ? a : b; }
+template <typename T> T constrain(T x, T a, T b) { return x < a ? a : (x > b ? b : x); }
+
+// Arduino String, as far as the modules under test need it
+struct String : std::string {
+  using std::string::string;
+  String() {}
+  String(const std::string& text) : std::string(text) {}
+  explicit String(int value) : std::string(std::to_string(value)) {}
+  explicit String(unsigned long value) : std::string(std::to_string(value)) {}
+
+  bool endsWith(const char* suffix) const {
+    size_t n = strlen(suffix);
+    return size() >= n && compare(size() - n, n, suffix) == 0;
+  }
+  int indexOf(const char* text) const {
+    size_t at = find(text);
+    return at == npos ? -1 : (int)at;
+  }
+  String substring(size_t from, size_t to) const { return String(substr(from, to - from)); }
+  void replace(const char* from, const char* to) {
+    for (size_t at = find(from); at != npos; at = find(from, at + strlen(to))) {
+      std::string::replace(at, strlen(from), to);
+    }
+  }
+};
+
+// Print, as used by buffer writers (snapshot.h)
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* data, size_t length) {
+    size_t n = 0;
+    while (n < length && write(data[n])) n++;
+    return n;
+  }
+  size_t write(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+  size_t print(const char* text) { return write(text); }
+};
+
+struct HostEsp {
+  uint32_t getFreeHeap() { return 40000; }
+};
+extern HostEsp ESP;
+
+// Serial output is dropped unless HOST_VERBOSE is set
+struct HostSerial {
+  void printf(const char* format, ...) {
+    if (!getenv("HOST_VERBOSE")) return;
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+  }
+  void println(const char* text) { printf("%s\n", text); }
+};
+extern HostSerial Serial;
+
+#endif
@@ -0,0 +1,77 @@
+// Host build: token arrays for the rule compiler and write-only documents
+#ifndef ARDUINOJSON_H
+#define ARDUINOJSON_H
+
+#include <Arduino.h>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+class JsonVariantConst {
+ public:
+  JsonVariantConst(float value) : number(value), text(nullptr) {}
+  JsonVariantConst(double value) : number((float)value), text(nullptr) {}
+  JsonVariantConst(int value) : number((float)value), text(nullptr) {}
+  JsonVariantConst(const char* value) : number(0), text(value) {}
+
+  template <typename T> bool is() const {
+    return std::is_same<T, const char*>::value ? text != nullptr : text == nullptr;
+  }
+  template <typename T> T as() const;
+
+ private:
+  float number;
+  const char* text;
+};
+template <> inline float JsonVariantConst::as<float>() const { return number; }
+template <> inline const char* JsonVariantConst::as<const char*>() const { return text; }
+
+class JsonArrayConst {
+ public:
+  JsonArrayConst() {}
+  JsonArrayConst(std::initializer_list<JsonVariantConst> tokens) : items(tokens) {}
+  JsonArrayConst(const std::vector<JsonVariantConst>& tokens) : items(tokens) {}
+  std::vector<JsonVariantConst>::const_iterator begin() const { return items.begin(); }
+  std::vector<JsonVariantConst>::const_iterator end() const { return items.end(); }
+
+ private:
+  std::vector<JsonVariantConst> items;
+};
+
+template <typename T> struct SerializedValue { T text; };
+template <typename T> SerializedValue<T> serialized(T text) { return SerializedValue<T>{text}; }
+
+// Values written by setFixed() (last one kept for checks)
+struct JsonSink {
+  template <typename T> JsonSink& operator=(const T&) { return *this; }
+  JsonSink& operator=(const SerializedValue<char*>& value);
+};
+extern char hostLastSerialized[32];
+inline JsonSink& JsonSink::operator=(const SerializedValue<char*>& value) {
+  snprintf(hostLastSerialized, sizeof(hostLastSerialized), "%s", value.text);
+  return *this;
+}
+
+class JsonObject {
+ public:
+  JsonSink operator[](const char*) const { return JsonSink(); }
+};
+
+class JsonArray {
+ public:
+  JsonObject createNestedObject() const { return JsonObject(); }
+};
+
+class JsonDocument {
+ public:
+  JsonSink operator[](const char*) { return JsonSink(); }
+  JsonArray createNestedArray(const char*) { return JsonArray(); }
+  bool overflowed() const { return false; }
+};
+
+class DynamicJsonDocument : public JsonDocument {
+ public:
+  explicit DynamicJsonDocument(size_t) {}
+};
+
+#endif
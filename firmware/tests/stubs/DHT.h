@@ -0,0 +1,19 @@
+// Host build of firmware modules: DHT returns the values the test sets
+#ifndef DHT_H
+#define DHT_H
+#include <Arduino.h>
+#define DHT11 11
+#define DHT22 22
+
+extern float hostDhtTemperature;  // NAN = failed read
+extern float hostDhtHumidity;
+extern int hostDhtReads;          // Sensor accesses so far
+
+class DHT {
+ public:
+  DHT(uint8_t, uint8_t) {}
+  void begin() {}
+  float readTemperature() { hostDhtReads++; return hostDhtTemperature; }
+  float readHumidity() { hostDhtReads++; return hostDhtHumidity; }
+};
+#endif
@@ -0,0 +1,4 @@
+#ifndef EEPROM_H
+#define EEPROM_H
+#include <Arduino.h>
+#endif
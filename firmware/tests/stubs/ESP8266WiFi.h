@@ -0,0 +1,13 @@
+// Host build of firmware modules: WiFi state only
+#ifndef ESP8266WIFI_H
+#define ESP8266WIFI_H
+#include <Arduino.h>
+
+enum wl_status_t { WL_DISCONNECTED = 0, WL_CONNECTED = 3 };
+
+struct HostWiFi {
+  wl_status_t state = WL_DISCONNECTED;
+  wl_status_t status() const { return state; }
+};
+extern HostWiFi WiFi;
+#endif
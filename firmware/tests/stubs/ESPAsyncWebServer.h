@@ -0,0 +1,54 @@
+// Host build of firmware modules: an async request the test drives. The
+// handler's response is kept on the request; the test plays the TCP stack
+// and pulls the body through the response's filler one segment at a time.
+#ifndef ESPASYNCWEBSERVER_H
+#define ESPASYNCWEBSERVER_H
+
+#include <Arduino.h>
+#include <functional>
+#include <map>
+
+typedef std::function<size_t(uint8_t*, size_t, size_t)> AwsResponseFiller;
+
+class AsyncWebServerResponse {
+ public:
+  AsyncWebServerResponse(int code, const String& contentType, size_t length, AwsResponseFiller filler)
+      : code(code), contentType(contentType), length(length), filler(filler) {}
+
+  void addHeader(const String& name, const String& value) { headers[name] = value; }
+  void setCode(int value) { code = value; }
+
+  int code;
+  String contentType;
+  size_t length;
+  AwsResponseFiller filler;  // Empty for responses without a body
+  std::map<std::string, String> headers;
+};
+
+class AsyncWebServerRequest {
+ public:
+  ~AsyncWebServerRequest() { delete response; }
+
+  bool hasHeader(const char* name) const { return headers.count(name) != 0; }
+  const String& header(const char* name) const { return headers.at(name); }
+
+  AsyncWebServerResponse* beginResponse(int code, const String& contentType = String(),
+                                        const String& = String()) {
+    return new AsyncWebServerResponse(code, contentType, 0, nullptr);
+  }
+  AsyncWebServerResponse* beginResponse(const String& contentType, size_t length, AwsResponseFiller filler) {
+    return new AsyncWebServerResponse(200, contentType, length, filler);
+  }
+  void send(int code, const String& contentType = String(), const String& content = String()) {
+    send(beginResponse(code, contentType, content));
+  }
+  void send(AsyncWebServerResponse* sent) {
+    delete response;
+    response = sent;
+  }
+
+  std::map<std::string, String> headers;    // Set by the test
+  AsyncWebServerResponse* response = nullptr;
+};
+
+#endif
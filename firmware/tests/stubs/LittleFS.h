@@ -0,0 +1,11 @@
+// Host build of firmware modules: LittleFS types only (no filesystem)
+#ifndef LITTLEFS_H
+#define LITTLEFS_H
+
+#include <Arduino.h>
+
+struct File {
+  explicit operator bool() const { return false; }
+};
+
+#endif
@@ -0,0 +1,12 @@
+// Host build of firmware modules: base64 length only (content not checked)
+#ifndef BASE64_H
+#define BASE64_H
+#include <Arduino.h>
+
+class base64 {
+ public:
+  static String encode(const uint8_t*, size_t length, bool = true) {
+    return String((length + 2) / 3 * 4, 'A');
+  }
+};
+#endif
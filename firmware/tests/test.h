@@ -0,0 +1,29 @@
+// Minimal host test helpers (no framework dependency)
+#ifndef TEST_H
+#define TEST_H
+
+#include <cstdio>
+
+extern int testFailures;
+
+#define CHECK(condition) \
+  do { \
+    if (!(condition)) { \
+      printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+      testFailures++; \
+    } \
+  } while (0)
+
+#define CHECK_EQ(actual, expected) \
+  do { \
+    long long a_ = (long long)(actual), e_ = (long long)(expected); \
+    if (a_ != e_) { \
+      printf("%s:%d: CHECK_EQ failed: %s = %lld, expected %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+      testFailures++; \
+    } \
+  } while (0)
+
+// Print the result and return the exit code for main()
+int testSummary(const char* name);
+
+#endif
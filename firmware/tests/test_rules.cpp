@@ -0,0 +1,266 @@
+// Host test of the rule compiler and evaluator (rules.cpp)
+#include "test.h"
+#include "rules.h"
+#include "sensors.h"
+#include "actuators.h"
+#include "timesync.h"
+#include <vector>
+
+// ========================================
+// Fakes for the modules rules.cpp uses
+// ========================================
+
+DeviceConfig deviceConfig;
+ControlConfig controlConfig;
+RuleProgram ruleProgram;
+SensorReading sensorReadings[MAX_SENSORS];
+
+static float outputs[MAX_ACTUATORS];
+static uint32_t outputRunMs[MAX_ACTUATORS];  // Pulse length of the last write
+static int actuatorWrites = 0;
+static bool clockSynced = false;
+
+uint8_t findActuator(const char* actuatorId) {
+  for (uint8_t i = 0; i < controlConfig.actuator_count; i++) {
+    if (strcmp(controlConfig.actuators[i].actuator_id, actuatorId) == 0) return i;
+  }
+  return ACTUATOR_INVALID;
+}
+
+float actuatorOutput(uint8_t index) { return outputs[index]; }
+bool actuatorManualHold(uint8_t) { return false; }
+bool timeSynced() { return clockSynced; }
+
+void setActuator(uint8_t index, float percent, uint32_t runMs) {
+  outputs[index] = percent;
+  outputRunMs[index] = runMs;
+  actuatorWrites++;
+}
+
+// Slot 0 is "air_temp" (DHT), "air_humidity" is its humidity
+bool findSensor(const char* name, uint8_t* index, bool* humidity) {
+  *index = 0;
+  *humidity = strcmp(name, "air_humidity") == 0;
+  return *humidity || strcmp(name, "air_temp") == 0;
+}
+
+// ========================================
+// Helpers
+// ========================================
+
+static void reset() {
+  memset(&controlConfig, 0, sizeof(controlConfig));
+  memset(&ruleProgram, 0, sizeof(ruleProgram));
+  memset(outputs, 0, sizeof(outputs));
+  controlConfig.actuator_count = 3;
+  strcpy(controlConfig.actuators[0].actuator_id, "fan");
+  strcpy(controlConfig.actuators[1].actuator_id, "pump");
+  strcpy(controlConfig.actuators[2].actuator_id, "heater");
+
+  hostMillis = 100000;
+  clockSynced = true;
+  sensorReadings[0].temperature = 2150;  // 21.5 °C
+  sensorReadings[0].humidity = 605;      // 60.5 %RH
+  sensorReadings[0].valid = true;
+  sensorReadings[0].readAt = hostMillis;
+}
+
+static bool compile(JsonArrayConst tokens, uint8_t actuator = 0) {
+  return compileRule(tokens, actuator, 100, 0);
+}
+
+// Compile one rule on actuator 0, run it, report whether it switched on
+static bool evaluate(JsonArrayConst tokens) {
+  memset(&ruleProgram, 0, sizeof(ruleProgram));
+  outputs[0] = 0;
+  if (!compile(tokens)) {
+    printf("  does not compile\n");
+    return false;
+  }
+  initializeRules();
+  triggerRules();
+  runRules();
+  return outputs[0] == 100;
+}
+
+// "air_temp air_temp and ..." with the given instruction count (odd);
+// sensor pushes keep the code small enough for several rules in the pool
+static std::vector<JsonVariantConst> chain(int instructions) {
+  std::vector<JsonVariantConst> tokens = {"air_temp"};
+  while ((int)tokens.size() < instructions) {
+    tokens.push_back("air_temp");
+    tokens.push_back("and");
+  }
+  return tokens;
+}
+
+// ========================================
+// Tests
+// ========================================
+
+static void testOperators() {
+  reset();
+  CHECK(evaluate({"air_temp", 22, "<"}));
+  CHECK(!evaluate({"air_temp", 21, "<"}));
+  CHECK(evaluate({"air_temp", 21.5, "<="}));
+  CHECK(evaluate({"air_temp", 21, ">"}));
+  CHECK(evaluate({"air_temp", 21.5, ">="}));
+  CHECK(evaluate({"air_temp", 21.5, "=="}));
+  CHECK(evaluate({"air_temp", 20, "!="}));
+  CHECK(evaluate({"air_humidity", 60.5, "=="}));
+  CHECK(evaluate({1, 1, "and"}));
+  CHECK(!evaluate({1, 0, "and"}));
+  CHECK(evaluate({0, 1, "or"}));
+  CHECK(!evaluate({0, 0, "or"}));
+  CHECK(evaluate({0, "not"}));
+  CHECK(!evaluate({2, "not"}));
+  CHECK(evaluate({1, 2, "+", 3, "=="}));
+  CHECK(evaluate({5, 2, "-", 3, "=="}));
+
+  outputs[1] = 40;
+  CHECK(evaluate({"output:pump", 40, "=="}));
+
+  hostMillis += 3600000;  // Any hour is >= 0 once the clock is synced
+  sensorReadings[0].readAt = hostMillis;
+  CHECK(evaluate({"hour", 0, ">=", "minute", 0, ">=", "and"}));
+}
+
+static void testCompilerRejects() {
+  reset();
+  CHECK(!compile({"+"}));                     // Underflow
+  CHECK(!compile({1, 2}));                    // Two values left
+  CHECK(!compile({"soil_7", 1, "<"}));        // Unknown sensor
+  CHECK(!compile({"output:valve", 1, "<"}));  // Unknown actuator
+  CHECK(!compile({1, "xor"}));
+  CHECK_EQ(ruleProgram.rule_count, 0);
+  CHECK_EQ(ruleProgram.code_length, 0);       // Rejected code is dropped
+}
+
+static void testDepthLimit() {
+  reset();
+
+  // Exactly RULE_STACK_DEPTH values, then reduced: valid and true
+  std::vector<JsonVariantConst> full;
+  for (int i = 0; i < RULE_STACK_DEPTH; i++) full.push_back(1);
+  for (int i = 1; i < RULE_STACK_DEPTH; i++) full.push_back("+");
+  full.push_back(RULE_STACK_DEPTH);
+  full.push_back("==");
+  CHECK(evaluate(full));
+
+  // One more value does not compile
+  std::vector<JsonVariantConst> deep;
+  for (int i = 0; i <= RULE_STACK_DEPTH; i++) deep.push_back(1);
+  for (int i = 0; i < RULE_STACK_DEPTH; i++) deep.push_back("and");
+  CHECK(!compile(deep));
+}
+
+static void testStaleInputs() {
+  reset();
+  JsonArrayConst warm = {"air_temp", 20, ">"};
+  CHECK(evaluate(warm));
+
+  hostMillis += 90001;  // Older than RULE_STALE_READING
+  CHECK(!evaluate(warm));
+
+  sensorReadings[0].readAt = hostMillis;
+  CHECK(evaluate(warm));
+
+  sensorReadings[0].readAt = 0;  // Never read
+  CHECK(!evaluate(warm));
+
+  reset();
+  clockSynced = false;
+  CHECK(!evaluate({"hour", 0, ">="}));
+}
+
+static void testBudget() {
+  reset();
+  CHECK(compile(chain(RULE_BUDGET_PER_TICK - 1)));
+  CHECK(!compile(chain(RULE_BUDGET_PER_TICK + 1)));  // Never fits in a tick
+
+  // Three rules of 39 instructions: one per runRules() call
+  memset(&ruleProgram, 0, sizeof(ruleProgram));
+  for (uint8_t i = 0; i < 3; i++) {
+    CHECK(compile(chain(39), i));
+  }
+  initializeRules();
+  triggerRules();
+
+  runRules();
+  CHECK(ruleActive(0) && !ruleActive(1) && !ruleActive(2));
+  runRules();
+  CHECK(ruleActive(1) && !ruleActive(2));
+  runRules();
+  CHECK(ruleActive(2));
+
+  // Nothing pending: no further actuator writes
+  int writes = actuatorWrites;
+  runRules();
+  CHECK_EQ(actuatorWrites, writes);
+}
+
+// One sample period: new reading, rules triggered and run
+static void sample(int16_t temperature, unsigned long elapsedMs) {
+  hostMillis += elapsedMs;
+  sensorReadings[0].temperature = temperature;
+  sensorReadings[0].readAt = hostMillis;
+  triggerRules();
+  runRules();
+}
+
+static void testPulse() {
+  // "pump on for 90 s when it gets warm"
+  reset();
+  CHECK(compileRule({"air_temp", 25, ">"}, 1, 100, 90));
+  initializeRules();
+
+  sample(2150, 0);
+  CHECK_EQ(outputs[1], 0);
+  CHECK(!ruleActive(0));
+
+  // Rising edge: started once, with the pulse length for the actuator
+  sample(2600, 30000);
+  CHECK_EQ(outputs[1], 100);
+  CHECK_EQ(outputRunMs[1], 90000);
+  CHECK(ruleActive(0));
+  unsigned long started = hostMillis;
+
+  // Condition stays true: no retrigger, the pulse keeps its start
+  int writes = actuatorWrites;
+  sample(2700, 30000);
+  sample(2700, 29999);
+  CHECK_EQ(actuatorWrites, writes);
+  CHECK(ruleActive(0));
+
+  // Released after the duration, between samples
+  hostMillis = started + 89999;
+  runRules();
+  CHECK(ruleActive(0));
+  hostMillis = started + 90000;
+  runRules();
+  CHECK_EQ(outputs[1], 0);
+  CHECK(!ruleActive(0));
+
+  // Still true on the next sample: no new edge, stays off
+  writes = actuatorWrites;
+  sample(2700, 1);
+  CHECK_EQ(actuatorWrites, writes);
+  CHECK_EQ(outputs[1], 0);
+
+  // False, then true again: a new pulse
+  sample(2000, 30000);
+  CHECK_EQ(outputs[1], 0);
+  sample(2600, 30000);
+  CHECK_EQ(outputs[1], 100);
+  CHECK(ruleActive(0));
+}
+
+int main() {
+  testOperators();
+  testCompilerRejects();
+  testDepthLimit();
+  testStaleInputs();
+  testBudget();
+  testPulse();
+  return testSummary("test_rules");
+}
@@ -0,0 +1,97 @@
+// Host test of the fixed-point sample helpers (sample.cpp): calibration
+// (integer interpolation and rounding) and decimal formatting
+#include "test.h"
+#include "sample.h"
+
+static SensorCalibration linear(int16_t gain, int16_t offset) {
+  SensorCalibration calibration = {};
+  calibration.mode = CALIBRATION_LINEAR;
+  calibration.gain = gain;
+  calibration.offset = offset;
+  return calibration;
+}
+
+static SensorCalibration table(std::initializer_list<int16_t> raw, std::initializer_list<int16_t> value) {
+  SensorCalibration calibration = {};
+  calibration.mode = CALIBRATION_TABLE;
+  for (int16_t r : raw) calibration.raw[calibration.point_count++] = r;
+  uint8_t i = 0;
+  for (int16_t v : value) calibration.value[i++] = v;
+  return calibration;
+}
+
+static void testNone() {
+  SensorCalibration none = {};
+  CHECK_EQ(calibrateSample(none, 2135), 2135);
+  CHECK_EQ(calibrateSample(none, -40), -40);
+}
+
+static void testLinear() {
+  CHECK_EQ(calibrateSample(linear(1000, -50), 2135), 2085);   // Offset only
+  CHECK_EQ(calibrateSample(linear(1015, 0), 2000), 2030);     // Gain only
+  CHECK_EQ(calibrateSample(linear(1015, 20), -2000), -2010);  // Both, negative
+
+  // Halves round away from zero, on both sides
+  CHECK_EQ(calibrateSample(linear(500, 0), 3), 2);
+  CHECK_EQ(calibrateSample(linear(500, 0), -3), -2);
+  CHECK_EQ(calibrateSample(linear(500, 0), -1), -1);
+  CHECK_EQ(calibrateSample(linear(333, 0), -1000), -333);
+  CHECK_EQ(calibrateSample(linear(333, 0), -2), -1);  // -0.666
+
+  // Extremes of the int16 storage do not overflow
+  CHECK_EQ(calibrateSample(linear(INT16_MAX, INT16_MAX), INT16_MAX), 1073676 + 32767);
+}
+
+static void testTable() {
+  SensorCalibration t = table({0, 1000, 2000}, {100, 1050, 2100});
+
+  // Points map exactly, segments interpolate
+  CHECK_EQ(calibrateSample(t, 0), 100);
+  CHECK_EQ(calibrateSample(t, 1000), 1050);
+  CHECK_EQ(calibrateSample(t, 2000), 2100);
+  CHECK_EQ(calibrateSample(t, 500), 575);
+  CHECK_EQ(calibrateSample(t, 1500), 1575);
+
+  // Past both ends: first / last segment extended
+  CHECK_EQ(calibrateSample(t, -1000), -850);
+  CHECK_EQ(calibrateSample(t, 3000), 3150);
+
+  // Negative slope: rounding to nearest, halves away from zero
+  SensorCalibration down = table({0, 3}, {0, -1});
+  CHECK_EQ(calibrateSample(down, 1), 0);    // -0.33
+  CHECK_EQ(calibrateSample(down, 2), -1);   // -0.67
+  CHECK_EQ(calibrateSample(down, -3), 1);   // Extrapolated below
+  SensorCalibration half = table({0, 2}, {0, -1});
+  CHECK_EQ(calibrateSample(half, 1), -1);   // -0.5
+  CHECK_EQ(calibrateSample(half, -1), 1);   // 0.5
+  CHECK_EQ(calibrateSample(half, 5), -3);   // -2.5, extrapolated above
+
+  // Unusable tables leave the value raw
+  SensorCalibration single = table({100}, {200});
+  CHECK_EQ(calibrateSample(single, 150), 150);
+  SensorCalibration unordered = table({100, 100}, {0, 50});
+  CHECK_EQ(calibrateSample(unordered, 150), 150);
+}
+
+static void testFormat() {
+  char text[16];
+  formatFixed(text, sizeof(text), 2135, SCALE_TEMPERATURE);
+  CHECK(strcmp(text, "21.35") == 0);
+  formatFixed(text, sizeof(text), -5, SCALE_TEMPERATURE);
+  CHECK(strcmp(text, "-0.05") == 0);
+  formatFixed(text, sizeof(text), -1005, SCALE_HUMIDITY);
+  CHECK(strcmp(text, "-100.5") == 0);
+  formatFixed(text, sizeof(text), 42, 1);
+  CHECK(strcmp(text, "42") == 0);
+
+  CHECK_EQ(toFixed(21.345f, SCALE_TEMPERATURE), 2135);
+  CHECK_EQ(toFixed(-0.05f, SCALE_HUMIDITY), -1);
+}
+
+int main() {
+  testNone();
+  testLinear();
+  testTable();
+  testFormat();
+  return testSummary("test_sample");
+}
@@ -0,0 +1,181 @@
+// Host test of the series codec (series.cpp) on a SYNTHETIC trace
+// (fixtures/greenhouse_trace.csv, generated, not recorded on a device):
+// lossless round trip and compression ratio, whole series and as history
+// blocks (history.cpp writeBlocks: one block per sensor and 10 min flush).
+// The ratios show the codec works as designed; they are not field results.
+#include "test.h"
+#include "series.h"
+#include "history.h"
+#include "sample.h"
+#include <vector>
+
+struct TracePoint {
+  uint32_t time;
+  int32_t temperature;     // centi-°C
+  int32_t humidity;        // deci-%RH, as read
+};
+
+static std::vector<TracePoint> loadTrace(const char* path) {
+  std::vector<TracePoint> trace;
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    printf("%s: not found\n", path);
+    return trace;
+  }
+
+  char line[96];
+  while (fgets(line, sizeof(line), f)) {
+    TracePoint point;
+    unsigned long time;
+    if (line[0] == '#' || sscanf(line, "%lu,%d,%d", &time, &point.temperature, &point.humidity) != 3) {
+      continue;
+    }
+    point.time = time;
+    trace.push_back(point);
+  }
+  fclose(f);
+  return trace;
+}
+
+// ========================================
+// Whole trace in one series
+// ========================================
+
+static void testRoundTrip(const std::vector<TracePoint>& trace) {
+  std::vector<uint8_t> buffer(trace.size() * 16);
+  SeriesEncoder encoder;
+  seriesBegin(encoder, buffer.data(), buffer.size(), 2);
+  for (const TracePoint& point : trace) {
+    int32_t values[2] = {point.temperature, point.humidity};
+    CHECK(seriesAppend(encoder, point.time, values));
+  }
+  CHECK_EQ(encoder.count, trace.size());
+
+  size_t length = seriesLength(encoder);
+  SeriesDecoder decoder;
+  seriesDecodeBegin(decoder, buffer.data(), length, 2, encoder.count);
+  uint32_t time;
+  int32_t values[2];
+  size_t index = 0;
+  for (; seriesNext(decoder, &time, values); index++) {
+    if (index >= trace.size()) break;
+    CHECK_EQ(time, trace[index].time);
+    CHECK_EQ(values[0], trace[index].temperature);
+    CHECK_EQ(values[1], trace[index].humidity);
+  }
+  CHECK_EQ(index, trace.size());
+
+  size_t raw = trace.size() * sizeof(HistoryRecord);
+  printf("  synthetic trace, series: %u points, %u bytes (%.2f bits/point), raw %u bytes, ratio %.1fx\n",
+         (unsigned)trace.size(), (unsigned)length, length * 8.0 / trace.size(),
+         (unsigned)raw, (double)raw / length);
+  CHECK(length * 4 < raw);  // At least 4x smaller than HistoryRecords
+}
+
+// ========================================
+// Same trace as history blocks
+// ========================================
+
+static void testHistoryBlocks(const std::vector<TracePoint>& trace) {
+  const uint32_t flushSeconds = HISTORY_FLUSH_INTERVAL / 1000;
+  size_t stored = 0, blocks = 0;
+  size_t next = 0;
+
+  while (next < trace.size()) {
+    // One flush: the samples of one 10 min window within one hour
+    uint32_t hour = trace[next].time / 3600;
+    uint32_t window = trace[next].time / flushSeconds;
+    size_t end = next;
+    while (end < trace.size() && trace[end].time / 3600 == hour &&
+           trace[end].time / flushSeconds == window) {
+      end++;
+    }
+
+    uint8_t block[HISTORY_BLOCK_MAX];
+    SeriesEncoder encoder;
+    seriesBegin(encoder, block, sizeof(block), 2);
+    for (size_t i = next; i < end; i++) {
+      int32_t values[2] = {trace[i].temperature, trace[i].humidity * (100 / SCALE_HUMIDITY)};
+      CHECK(seriesAppend(encoder, trace[i].time - hour * 3600, values));
+    }
+
+    SeriesDecoder decoder;
+    seriesDecodeBegin(decoder, block, seriesLength(encoder), 2, encoder.count);
+    uint32_t second;
+    int32_t values[2];
+    for (size_t i = next; i < end; i++) {
+      CHECK(seriesNext(decoder, &second, values));
+      CHECK_EQ(second + hour * 3600, trace[i].time);
+      CHECK_EQ(values[0], trace[i].temperature);
+      CHECK_EQ(values[1], trace[i].humidity * (100 / SCALE_HUMIDITY));
+    }
+    CHECK(!seriesNext(decoder, &second, values));
+
+    stored += sizeof(HistoryBlockHeader) + seriesLength(encoder);
+    blocks++;
+    next = end;
+  }
+
+  size_t raw = trace.size() * sizeof(HistoryRecord);
+  printf("  synthetic trace, history: %u blocks, %u bytes with headers, raw %u bytes, ratio %.1fx\n",
+         (unsigned)blocks, (unsigned)stored, (unsigned)raw, (double)raw / stored);
+  CHECK(stored * 2 < raw);
+}
+
+// ========================================
+// Edge cases
+// ========================================
+
+static void testBuckets() {
+  // Every bucket, both signs, a repeated time and a full 32 bit jump
+  const uint32_t times[] = {0, 30, 60, 60, 61, 400, 5000, 4000000000UL};
+  const int32_t values[] = {0, 7, -8, 200, -255, 2047, -2048, 70000, INT32_MIN / 2, 0, 0, 1};
+  uint8_t buffer[128];
+  SeriesEncoder encoder;
+  seriesBegin(encoder, buffer, sizeof(buffer), 1);
+  for (size_t i = 0; i < 8; i++) {
+    CHECK(seriesAppend(encoder, times[i], &values[i]));
+  }
+
+  SeriesDecoder decoder;
+  seriesDecodeBegin(decoder, buffer, seriesLength(encoder), 1, encoder.count);
+  uint32_t time;
+  int32_t value;
+  for (size_t i = 0; i < 8; i++) {
+    CHECK(seriesNext(decoder, &time, &value));
+    CHECK_EQ(time, times[i]);
+    CHECK_EQ(value, values[i]);
+  }
+}
+
+static void testFullBuffer() {
+  // The point that does not fit leaves the series as it was
+  uint8_t buffer[8];
+  SeriesEncoder encoder;
+  seriesBegin(encoder, buffer, sizeof(buffer), 1);
+  int32_t value = 100;
+  CHECK(seriesAppend(encoder, 1000, &value));  // 32 + 13 bits, 19 left
+  size_t bits = encoder.bits;
+  value = 100000;
+  CHECK(!seriesAppend(encoder, 1030, &value));
+  CHECK_EQ(encoder.bits, bits);
+  CHECK_EQ(encoder.count, 1);
+
+  // Truncated data ends the decoding instead of reading past it
+  value = 101;
+  CHECK(seriesAppend(encoder, 1030, &value));
+  SeriesDecoder decoder;
+  seriesDecodeBegin(decoder, buffer, 4, 1, 2);
+  uint32_t time;
+  CHECK(!seriesNext(decoder, &time, &value));
+}
+
+int main() {
+  std::vector<TracePoint> trace = loadTrace("fixtures/greenhouse_trace.csv");
+  CHECK(trace.size() > 100);
+  testRoundTrip(trace);
+  testHistoryBlocks(trace);
+  testBuckets();
+  testFullBuffer();
+  return testSummary("test_series");
+}
@@ -0,0 +1,344 @@
+// Host test of the local API against sampling: snapshot.cpp serving
+// concurrent requests while loop() passes run readSensors() and the upload
+// (sensors.cpp). The test plays the TCP stack: between loop() steps, and
+// while loop() waits on the backend, each client either sends a request
+// (handler call) or receives one segment of its response.
+//
+// Time is simulated with a fixed cost per step (below), so the numbers are
+// a model of the scheduling, not device measurements. What is checked:
+// sample gaps do not grow under load, handlers never touch the sensors or
+// rebuild a snapshot per request, in-flight responses survive a rebuild and
+// requests are answered while loop() is blocked in the upload.
+#include "test.h"
+#include "snapshot.h"
+#include "sensors.h"
+#include "transport.h"
+#include "timesync.h"
+#include <ESP8266WiFi.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// ========================================
+// Timing model (simulated ms)
+// ========================================
+
+#define SENSOR_READ_INTERVAL 30000  // As in the sketch
+#define LOOP_WORK_MS 5              // Rest of a loop() pass
+#define LOOP_DELAY_MS 10            // delay(10) at the end of loop()
+#define TCP_EVENT_MS 1              // One handler call or one response segment
+#define TCP_SEGMENT 536             // Default lwIP MSS on the ESP8266
+#define BACKEND_CALL_MS 4000        // Upload on a slow uplink, loop() blocked
+#define STATUS_MAX_AGE 1000         // Live snapshot, as /api/status
+
+#define PHASE_MS (10 * 60 * 1000UL)
+#define LOAD_CLIENTS 5
+
+// ========================================
+// Fakes for the modules sensors.cpp uses
+// ========================================
+
+DeviceConfig deviceConfig;
+CalibrationTable calibrationTable;
+
+static int uploads = 0;
+static bool uploading = false;
+static void serveFor(unsigned long ms);
+
+bool formatTimestamp(uint32_t, char*, size_t) { return false; }
+
+// Blocks loop() like the HTTPS call; the TCP stack keeps running
+bool transportCall(const char*, const JsonDocument&, JsonDocument*, TransportAuth) {
+  uploading = true;
+  serveFor(BACKEND_CALL_MS);
+  uploading = false;
+  uploads++;
+  return true;
+}
+
+// ========================================
+// Endpoints: readings (new version per sample), status (live)
+// ========================================
+
+enum Endpoint { READINGS, STATUS };
+
+static Snapshot readingsSnapshot;
+static Snapshot statusSnapshot;
+static int writerCalls[2];
+static std::map<std::pair<int, uint32_t>, std::string> bodies;  // Snapshot per version
+
+static void writeSampleTime(SnapshotWriter& out, int32_t temperature, int32_t humidity, uint32_t readAt) {
+  char temp[12], hum[12];
+  formatFixed(temp, sizeof(temp), temperature, SCALE_TEMPERATURE);
+  formatFixed(hum, sizeof(hum), humidity, SCALE_HUMIDITY);
+  out.printf("\"temperature\":%s,\"humidity\":%s,\"uptime_ms\":%lu}", temp, hum, (unsigned long)readAt);
+}
+
+// Same shape as webserver.cpp writeReadingsJson
+static void writeReadings(SnapshotWriter& out) {
+  writerCalls[READINGS]++;
+  out.print("{\"latest\":[");
+  bool first = true;
+  for (int i = 0; i < MAX_SENSORS; i++) {
+    const SensorReading& reading = sensorReadings[i];
+    if (deviceConfig.sensors[i].type == 0 || reading.readAt == 0) continue;
+    out.printf("%s{\"slot\":%d,\"name\":\"%s\",", first ? "" : ",", i + 1, deviceConfig.sensors[i].name);
+    writeSampleTime(out, reading.temperature, reading.humidity, reading.readAt);
+    first = false;
+  }
+  out.print("],\"history\":[");
+  for (uint8_t i = 0; i < readingHistoryCount(); i++) {
+    const ReadingSample& sample = readingHistoryAt(i);
+    out.printf("%s{\"slot\":%d,", i ? "," : "", sample.slot + 1);
+    writeSampleTime(out, sample.temperature, sample.humidity, sample.readAt);
+  }
+  out.print("]}");
+}
+
+static void writeStatus(SnapshotWriter& out) {
+  writerCalls[STATUS]++;
+  out.printf("{\"uptime_s\":%lu,\"free_heap\":%u}", millis() / 1000, ESP.getFreeHeap());
+}
+
+static void handle(Endpoint endpoint, AsyncWebServerRequest* request) {
+  Snapshot& snapshot = endpoint == READINGS ? readingsSnapshot : statusSnapshot;
+  if (endpoint == READINGS) {
+    serveSnapshot(request, snapshot, writeReadings, sensorDataVersion, "application/json");
+  } else {
+    serveSnapshot(request, snapshot, writeStatus, liveVersion(snapshot, STATUS_MAX_AGE), "application/json");
+  }
+  bodies[std::make_pair((int)endpoint, snapshot.version)].assign(snapshot.data.get(), snapshot.length);
+}
+
+// ========================================
+// TCP stack: clients requesting back to back
+// ========================================
+
+struct Client {
+  Endpoint endpoint;
+  bool revalidate;                  // Sends If-None-Match with its last ETag
+  AsyncWebServerRequest* request;   // In flight, nullptr = about to send
+  std::string body;
+  String etag;
+  uint32_t version;                 // Snapshot version of the response
+  unsigned long sentAt;
+};
+
+struct Stats {
+  int answered;
+  int notModified;
+  int answeredDuringUpload;
+  int olderThanSnapshot;            // Completed after the snapshot was rebuilt
+  unsigned long maxResponseMs;
+};
+
+static std::vector<Client> clients;
+static Stats stats;
+
+static void complete(Client& client) {
+  unsigned long elapsed = millis() - client.sentAt;
+  stats.maxResponseMs = max(stats.maxResponseMs, elapsed);
+  stats.answered++;
+  if (uploading) {
+    stats.answeredDuringUpload++;
+  }
+  delete client.request;
+  client.request = nullptr;
+}
+
+static void tcpEvent(Client& client) {
+  hostMillis += TCP_EVENT_MS;
+
+  if (!client.request) {
+    client.request = new AsyncWebServerRequest();
+    if (client.revalidate && !client.etag.empty()) {
+      client.request->headers["If-None-Match"] = client.etag;
+    }
+    client.sentAt = millis();
+    client.body.clear();
+    handle(client.endpoint, client.request);
+
+    AsyncWebServerResponse* response = client.request->response;
+    CHECK(response != nullptr);
+    if (response->code == 304) {
+      stats.notModified++;
+      complete(client);
+      return;
+    }
+    CHECK_EQ(response->code, 200);
+    client.etag = response->headers["ETag"];
+    client.version = strtoul(client.etag.c_str() + 1, nullptr, 16);
+    return;
+  }
+
+  // Next segment of the body, pulled as the window allows
+  AsyncWebServerResponse* response = client.request->response;
+  uint8_t segment[TCP_SEGMENT];
+  size_t n = response->filler(segment, sizeof(segment), client.body.size());
+  client.body.append((const char*)segment, n);
+  if (client.body.size() < response->length) {
+    return;
+  }
+
+  const Snapshot& snapshot = client.endpoint == READINGS ? readingsSnapshot : statusSnapshot;
+  if (snapshot.version != client.version) {
+    stats.olderThanSnapshot++;
+  }
+  CHECK(client.body == bodies[std::make_pair((int)client.endpoint, client.version)]);
+  complete(client);
+}
+
+// The TCP stack runs while loop() yields (delay, blocking calls)
+static void serveFor(unsigned long ms) {
+  unsigned long end = millis() + ms;
+  while ((long)(millis() - end) < 0) {
+    if (clients.empty()) {
+      hostMillis = end;
+      break;
+    }
+    for (Client& client : clients) {
+      tcpEvent(client);
+    }
+  }
+}
+
+// ========================================
+// loop(): the sampling part of the sketch's loop()
+// ========================================
+
+struct Phase {
+  int samples;
+  int sensorReads;
+  unsigned long minGap;
+  unsigned long maxGap;
+};
+
+static unsigned long lastSensorRead = 0;
+
+static void recordGaps(Phase& phase, const unsigned long* before) {
+  for (int i = 0; i < MAX_SENSORS; i++) {
+    if (!dhtSensors[i] || before[i] == 0) continue;
+    unsigned long gap = sensorReadings[i].readAt - before[i];
+    phase.minGap = min(phase.minGap, gap);
+    phase.maxGap = max(phase.maxGap, gap);
+  }
+}
+
+static void loopPass(Phase& phase) {
+  hostMillis += LOOP_WORK_MS;
+
+  unsigned long now = millis();
+  if (now - lastSensorRead >= SENSOR_READ_INTERVAL) {
+    unsigned long before[MAX_SENSORS];
+    for (int i = 0; i < MAX_SENSORS; i++) before[i] = sensorReadings[i].readAt;
+
+    int reads = hostDhtReads;
+    readSensors();
+    phase.sensorReads += hostDhtReads - reads;
+    phase.samples++;
+    recordGaps(phase, before);
+
+    if (WiFi.status() == WL_CONNECTED) {
+      sendSensorReadings();
+    }
+    lastSensorRead = now;
+  }
+
+  serveFor(LOOP_DELAY_MS);
+}
+
+static Phase runPhase(int clientCount) {
+  clients.clear();
+  for (int i = 0; i < clientCount; i++) {
+    // Mostly readings, one live status poller, one revalidating client
+    Client client = {};
+    client.endpoint = i == 1 ? STATUS : READINGS;
+    client.revalidate = i == 2;
+    clients.push_back(client);
+  }
+
+  Phase phase = {0, 0, (unsigned long)-1, 0};
+  unsigned long end = millis() + PHASE_MS;
+  while ((long)(millis() - end) < 0) {
+    loopPass(phase);
+  }
+
+  for (Client& client : clients) {
+    delete client.request;
+  }
+  clients.clear();
+  return phase;
+}
+
+// ========================================
+// Tests
+// ========================================
+
+static void setup() {
+  memset(&deviceConfig, 0, sizeof(deviceConfig));
+  deviceConfig.sensors[0] = {4, 1, "air_temp"};
+  deviceConfig.sensors[1] = {5, 1, "soil_temp"};
+  initializeSensors();
+
+  hostDhtTemperature = 21.5f;
+  hostDhtHumidity = 60.0f;
+  WiFi.state = WL_CONNECTED;
+  hostMillis = 1000;
+}
+
+static void testSamplingUnderLoad() {
+  Phase idle = runPhase(0);
+  stats = Stats();
+  int uploadsBefore = uploads;
+  int writesBefore = writerCalls[READINGS];
+  Phase load = runPhase(LOAD_CLIENTS);
+  int rebuilds = writerCalls[READINGS] - writesBefore;
+
+  printf("  simulated, idle: %d samples, gap %lu..%lu ms\n", idle.samples, idle.minGap, idle.maxGap);
+  printf("  simulated, %d clients: %d samples, gap %lu..%lu ms, %d responses (%d while uploading), "
+         "%d readings rebuilds, slowest response %lu ms\n",
+         LOAD_CLIENTS, load.samples, load.minGap, load.maxGap, stats.answered,
+         stats.answeredDuringUpload, rebuilds, stats.maxResponseMs);
+
+  // Sampling keeps its period: requests add at most one event per client
+  // to the loop() pass that samples
+  CHECK_EQ(load.samples, idle.samples);
+  CHECK(load.minGap >= SENSOR_READ_INTERVAL);
+  CHECK(load.maxGap <= idle.maxGap + LOAD_CLIENTS * TCP_EVENT_MS);
+  CHECK(idle.maxGap <= SENSOR_READ_INTERVAL + LOOP_WORK_MS + LOOP_DELAY_MS);
+  CHECK_EQ(uploads - uploadsBefore, load.samples);
+
+  // Handlers answer from the snapshots: sensors read only by readSensors(),
+  // one rebuild per new sample however many requests
+  CHECK_EQ(load.sensorReads, idle.sensorReads);
+  CHECK_EQ(load.sensorReads, load.samples * 2 * 2);
+  CHECK(rebuilds <= load.samples + 1);
+  CHECK(stats.answered > 100 * rebuilds);
+  CHECK(stats.notModified > 0);
+
+  // Answered while loop() waits on the backend, and in-flight bodies stay
+  // intact when a new sample rebuilds the snapshot (checked per response)
+  CHECK(stats.answeredDuringUpload > 0);
+  CHECK(stats.maxResponseMs <= 100);
+  CHECK(stats.olderThanSnapshot > 0);
+}
+
+// Live snapshot: rebuilt once per max age, not per request
+static void testLiveSnapshot() {
+  Snapshot snapshot = {};
+  int writes = writerCalls[STATUS];
+  for (int i = 0; i < 50; i++) {
+    AsyncWebServerRequest request;
+    serveSnapshot(&request, snapshot, writeStatus, liveVersion(snapshot, STATUS_MAX_AGE), "application/json");
+    CHECK_EQ(request.response->code, 200);
+    hostMillis += 100;
+  }
+  CHECK_EQ(writerCalls[STATUS] - writes, 5);
+}
+
+int main() {
+  setup();
+  testSamplingUnderLoad();
+  testLiveSnapshot();
+  return testSummary("test_snapshot");
+}
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""
+Local API load script for a real ESP8266 Greenhouse device (v3.2.0+).
+
+Measures on hardware what tests/test_snapshot.cpp checks on a simulated
+loop(): whether concurrent requests to the device's web server delay the
+main loop or the 30 s sensor sampling. No device results are recorded in
+the repository; run it against a device to get them. Two phases of equal
+length:
+
+  idle  no requests besides a /metrics and /api/readings poll every 5 s
+  load  the same poll plus --clients threads requesting the local API
+        (/api/status, /api/readings, /api/history, /metrics, /firmware/info)
+        back to back
+
+Per phase it reports, from /metrics:
+  - mean loop pass (delta of greenhouse_loop_duration_seconds_sum / _count)
+  - greenhouse_loop_duration_max_seconds at the end (max since boot)
+  - failed sensor reads in the phase
+and from /api/readings the longest gap between successive samples of each
+sensor (should stay at SENSOR_READ_INTERVAL, 30 s, plus loop jitter).
+
+Exit code 1 if under load a sample gap exceeds --max-gap or the mean loop
+pass grows by more than --max-loop-growth.
+
+Usage:
+  python3 load_test.py 192.168.1.50 [--duration 300] [--clients 4]
+"""
+
+import argparse
+import json
+import re
+import sys
+import threading
+import time
+import urllib.error
+import urllib.request
+from datetime import datetime
+
+LOAD_PATHS = ["/api/status", "/api/readings", "/api/history", "/metrics", "/firmware/info"]
+POLL_INTERVAL = 5.0
+METRIC_LINE = re.compile(r'^([a-z_]+)(\{[^}]*\})? ([0-9.eE+-]+)$')
+
+
+def fetch(base: str, path: str, timeout: float = 10.0) -> bytes:
+    with urllib.request.urlopen(base + path, timeout=timeout) as response:
+        return response.read()
+
+
+def read_metrics(base: str) -> dict:
+    metrics = {}
+    for line in fetch(base, "/metrics").decode().splitlines():
+        match = METRIC_LINE.match(line)
+        if match:
+            name, labels, value = match.groups()
+            metrics[name + (labels or "")] = float(value)
+    return metrics
+
+
+def read_failures(metrics: dict) -> float:
+    return sum(v for k, v in metrics.items() if k.startswith("greenhouse_sensor_read_failures_total"))
+
+
+def sample_time(item: dict) -> float:
+    # ISO 8601 once SNTP synced, else the device's millis() stamp
+    if "ts" in item:
+        return datetime.strptime(item["ts"], "%Y-%m-%dT%H:%M:%S.%fZ").timestamp()
+    return item["uptime_ms"] / 1000.0
+
+
+class Requester(threading.Thread):
+    def __init__(self, base: str, index: int, stop: threading.Event):
+        super().__init__(daemon=True)
+        self.base, self.index, self.stop = base, index, stop
+        self.ok = self.errors = 0
+        self.latencies = []
+
+    def run(self) -> None:
+        i = self.index
+        while not self.stop.is_set():
+            path = LOAD_PATHS[i % len(LOAD_PATHS)]
+            i += 1
+            start = time.monotonic()
+            try:
+                fetch(self.base, path)
+                self.ok += 1
+                self.latencies.append(time.monotonic() - start)
+            except urllib.error.HTTPError as error:
+                # 503 from /firmware/info (hash not ready, sharing off) is an answer
+                if error.code == 503:
+                    self.ok += 1
+                else:
+                    self.errors += 1
+            except (urllib.error.URLError, OSError):
+                self.errors += 1
+
+
+def run_phase(base: str, name: str, duration: float, clients: int) -> dict:
+    stop = threading.Event()
+    requesters = [Requester(base, i, stop) for i in range(clients)]
+
+    before = read_metrics(base)
+    for requester in requesters:
+        requester.start()
+
+    last_sample = {}
+    max_gap = {}
+    end = time.monotonic() + duration
+    while time.monotonic() < end:
+        try:
+            readings = json.loads(fetch(base, "/api/readings"))
+        except (urllib.error.URLError, OSError, ValueError) as error:
+            print("  %s: readings poll failed (%s)" % (name, error))
+            readings = {"latest": []}
+        for item in readings["latest"]:
+            slot, t = item["slot"], sample_time(item)
+            if slot in last_sample and t > last_sample[slot]:
+                max_gap[slot] = max(max_gap.get(slot, 0), t - last_sample[slot])
+            last_sample[slot] = t
+        time.sleep(POLL_INTERVAL)
+
+    stop.set()
+    for requester in requesters:
+        requester.join()
+    after = read_metrics(base)
+
+    passes = after["greenhouse_loop_duration_seconds_count"] - before["greenhouse_loop_duration_seconds_count"]
+    busy = after["greenhouse_loop_duration_seconds_sum"] - before["greenhouse_loop_duration_seconds_sum"]
+    latencies = sorted(l for r in requesters for l in r.latencies)
+    return {
+        "name": name,
+        "passes": passes,
+        "mean_loop_ms": busy / passes * 1000 if passes else 0,
+        "max_loop_ms": after["greenhouse_loop_duration_max_seconds"] * 1000,
+        "read_failures": read_failures(after) - read_failures(before),
+        "max_gap": max(max_gap.values()) if max_gap else None,
+        "requests": sum(r.ok for r in requesters),
+        "errors": sum(r.errors for r in requesters),
+        "p95_ms": latencies[int(len(latencies) * 0.95)] * 1000 if latencies else None,
+    }
+
+
+def show(result: dict, duration: float) -> None:
+    gap = "%.1f s" % result["max_gap"] if result["max_gap"] is not None else "n/a"
+    print("%-5s loop passes %d, mean %.3f ms, max since boot %.1f ms, longest sample gap %s, "
+          "read failures %d" % (result["name"], result["passes"], result["mean_loop_ms"],
+                                result["max_loop_ms"], gap, result["read_failures"]))
+    if result["requests"] or result["errors"]:
+        print("      %d requests (%.1f/s), %d errors, p95 latency %.0f ms"
+              % (result["requests"], result["requests"] / duration, result["errors"],
+                 result["p95_ms"] or 0))
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("host", help="device address (IP or name.local)")
+    parser.add_argument("--duration", type=float, default=300, help="seconds per phase")
+    parser.add_argument("--clients", type=int, default=4, help="concurrent request threads under load")
+    parser.add_argument("--max-gap", type=float, default=32.0, help="longest sample gap accepted, s")
+    parser.add_argument("--max-loop-growth", type=float, default=2.0,
+                        help="accepted mean loop pass under load / idle")
+    args = parser.parse_args()
+
+    base = "http://%s" % args.host
+    idle = run_phase(base, "idle", args.duration, 0)
+    show(idle, args.duration)
+    load = run_phase(base, "load", args.duration, args.clients)
+    show(load, args.duration)
+
+    failed = False
+    if load["max_gap"] is not None and load["max_gap"] > args.max_gap:
+        print("FAIL: sampling delayed under load (gap %.1f s > %.1f s)" % (load["max_gap"], args.max_gap))
+        failed = True
+    if idle["mean_loop_ms"] and load["mean_loop_ms"] > idle["mean_loop_ms"] * args.max_loop_growth:
+        print("FAIL: mean loop pass %.3f ms under load vs %.3f ms idle"
+              % (load["mean_loop_ms"], idle["mean_loop_ms"]))
+        failed = True
+    if not failed:
+        print("OK")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
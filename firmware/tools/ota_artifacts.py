@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""
+Build OTA artifacts for ESP8266 Greenhouse firmware (v3.2.0+).
+
+Given the compiled sketch binary (Arduino IDE: Sketch > Export compiled
+Binary) this produces:
+  - <name>.bin.gz   gzip image, written as-is by Updater and expanded by the
+                    bootloader on the next boot
+  - <name>.delta    binary delta against a previous release (--base), applied
+                    on the device while streaming (format in ota.cpp)
+
+and prints a manifest. Its "rows" are the firmware_versions /
+firmware_deltas rows for the files to upload, with each hash taken from
+the file it describes:
+  checksum_sha256 / checksum_md5   the uploaded file (.bin.gz, or .bin
+                                   with --plain), verified by the device
+  image_sha256                     the uncompressed image, matched against
+                                   /firmware/info of LAN peers
+Upload the files under --storage-prefix in the firmware bucket, then
+insert the rows (tools/release.sh does the build and this step).
+
+Usage:
+  python3 ota_artifacts.py firmware.bin --version v3.2.1 [--base previous.bin]
+                           [--base-version v3.2.0] [--plain] [--out dist/]
+"""
+
+import argparse
+import gzip
+import hashlib
+import json
+import os
+import struct
+import sys
+
+PATCH_MAGIC = b"SDP1"
+BLOCK = 16          # Match seed length
+MIN_COPY = 24       # Shorter matches are cheaper as literals
+HEADER_LITERAL = 4  # Flash mode/size bytes may differ on the device
+
+
+def make_delta(base: bytes, target: bytes) -> bytes:
+    index = {}
+    for i in range(0, len(base) - BLOCK + 1, 4):
+        index.setdefault(base[i:i + BLOCK], i)
+
+    out = bytearray(PATCH_MAGIC + struct.pack("<I", len(target)))
+    literal = bytearray()
+
+    def flush_literal():
+        if literal:
+            out.extend(b"I" + struct.pack("<I", len(literal)) + literal)
+            literal.clear()
+
+    j = 0
+    while j < len(target):
+        src = index.get(target[j:j + BLOCK]) if j >= HEADER_LITERAL else None
+        if src is not None:
+            length = BLOCK
+            while (j + length < len(target) and src + length < len(base)
+                   and target[j + length] == base[src + length]):
+                length += 1
+            if length >= MIN_COPY:
+                flush_literal()
+                out.extend(b"C" + struct.pack("<II", src, length))
+                j += length
+                continue
+        literal.append(target[j])
+        j += 1
+
+    flush_literal()
+    return bytes(out)
+
+
+def apply_delta(base: bytes, patch: bytes) -> bytes:
+    """Reference implementation of the device-side interpreter."""
+    assert patch[:4] == PATCH_MAGIC
+    size = struct.unpack_from("<I", patch, 4)[0]
+    out = bytearray()
+    pos = 8
+    while pos < len(patch):
+        op = patch[pos:pos + 1]
+        if op == b"C":
+            offset, length = struct.unpack_from("<II", patch, pos + 1)
+            out.extend(base[offset:offset + length])
+            pos += 9
+        elif op == b"I":
+            length = struct.unpack_from("<I", patch, pos + 1)[0]
+            out.extend(patch[pos + 5:pos + 5 + length])
+            pos += 5 + length
+        else:
+            raise ValueError("invalid opcode at %d" % pos)
+    assert len(out) == size
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("image", help="compiled firmware .bin")
+    parser.add_argument("--base", help="previous release .bin to build a delta against")
+    parser.add_argument("--base-version", help="firmware version string of --base (e.g. v3.2.0)")
+    parser.add_argument("--version", help="firmware version string of image (fills the rows)")
+    parser.add_argument("--plain", action="store_true", help="upload the uncompressed .bin instead of .bin.gz")
+    parser.add_argument("--storage-prefix", default="firmware",
+                        help="bucket/folder of the uploaded files in storage_path")
+    parser.add_argument("--out", default=".", help="output directory")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+
+    name = os.path.splitext(os.path.basename(args.image))[0]
+    os.makedirs(args.out, exist_ok=True)
+
+    gz = gzip.compress(image, compresslevel=9, mtime=0)
+    gz_path = os.path.join(args.out, name + ".bin.gz")
+    with open(gz_path, "wb") as f:
+        f.write(gz)
+
+    manifest = {
+        "image": {
+            "file_size": len(image),
+            "checksum_sha256": hashlib.sha256(image).hexdigest(),
+            "checksum_md5": hashlib.md5(image).hexdigest(),
+        },
+        "gzip": {
+            "path": gz_path,
+            "file_size": len(gz),
+            "checksum_sha256": hashlib.sha256(gz).hexdigest(),
+            "ratio": round(len(gz) / len(image), 3),
+        },
+    }
+
+    if args.base and not args.base_version:
+        sys.exit("--base needs --base-version")
+    if args.base:
+        with open(args.base, "rb") as f:
+            base = f.read()
+        delta = make_delta(base, image)
+        if apply_delta(base, delta) != image:
+            sys.exit("delta self-check failed")
+
+        delta_path = os.path.join(args.out, name + ".delta")
+        with open(delta_path, "wb") as f:
+            f.write(delta)
+
+        manifest["delta"] = {
+            "path": delta_path,
+            "base_version": args.base_version,
+            "base_md5": hashlib.md5(base).hexdigest(),
+            "file_size": len(delta),
+            "target_sha256": hashlib.sha256(image).hexdigest(),
+            "ratio": round(len(delta) / len(image), 3),
+        }
+
+    if args.version:
+        upload_path = args.image if args.plain else gz_path
+        with open(upload_path, "rb") as f:
+            upload = f.read()
+        upload_name = os.path.basename(upload_path)
+        if args.version not in upload_name:
+            upload_name = "%s-%s" % (args.version, upload_name)
+        manifest["upload"] = {upload_name: upload_path}
+        manifest["rows"] = {
+            "firmware_versions": {
+                "version": args.version,
+                "storage_path": "%s/%s" % (args.storage_prefix, upload_name),
+                "file_size": len(upload),
+                "checksum_sha256": hashlib.sha256(upload).hexdigest(),
+                "checksum_md5": hashlib.md5(upload).hexdigest(),
+                "image_sha256": hashlib.sha256(image).hexdigest(),
+            },
+        }
+        if args.base:
+            delta_name = "%s-from-%s.delta" % (args.version, args.base_version)
+            manifest["upload"][delta_name] = manifest["delta"]["path"]
+            manifest["rows"]["firmware_deltas"] = {
+                "base_version": args.base_version,
+                "base_md5": manifest["delta"]["base_md5"],
+                "storage_path": "%s/%s" % (args.storage_prefix, delta_name),
+                "file_size": manifest["delta"]["file_size"],
+                "target_sha256": manifest["delta"]["target_sha256"],
+            }
+
+    print(json.dumps(manifest, indent=2))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the Supabase Realtime command channel (ESP8266 v3.2.0).
+
+Speaks just enough of the Phoenix WebSocket protocol for realtime.cpp:
+phx_join / heartbeat replies and "command" broadcasts shaped like the
+broadcast_device_command() trigger ({id} only). Standard library only.
+
+Build the firmware against it:
+  -DREALTIME_HOST=\\"<this machine>\\" -DREALTIME_PORT=4000 -DREALTIME_USE_SSL=0
+
+Then type a command id (or just Enter for a random one) to announce it.
+The device must log "Realtime: command <id> announced" and send a
+heartbeat within a few seconds (at most one early heartbeat per 5 s).
+
+  python3 realtime_standin.py [--port 4000] [--every SECONDS]
+"""
+
+import argparse
+import base64
+import hashlib
+import json
+import socket
+import struct
+import sys
+import threading
+import time
+import uuid
+
+WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+clients = []            # (socket, joined topic or None)
+clients_lock = threading.Lock()
+
+
+def log(message: str) -> None:
+    print("[%s] %s" % (time.strftime("%H:%M:%S"), message), flush=True)
+
+
+def handshake(conn: socket.socket) -> bool:
+    request = b""
+    while b"\r\n\r\n" not in request:
+        chunk = conn.recv(1024)
+        if not chunk:
+            return False
+        request += chunk
+
+    headers = {}
+    for line in request.decode("latin-1").split("\r\n")[1:]:
+        if ":" in line:
+            name, value = line.split(":", 1)
+            headers[name.strip().lower()] = value.strip()
+
+    key = headers.get("sec-websocket-key")
+    if not key:
+        return False
+    accept = base64.b64encode(hashlib.sha1((key + WS_GUID).encode()).digest()).decode()
+    conn.sendall(("HTTP/1.1 101 Switching Protocols\r\n"
+                  "Upgrade: websocket\r\nConnection: Upgrade\r\n"
+                  "Sec-WebSocket-Accept: %s\r\n\r\n" % accept).encode())
+    return True
+
+
+def recv_exact(conn: socket.socket, n: int) -> bytes:
+    data = b""
+    while len(data) < n:
+        chunk = conn.recv(n - len(data))
+        if not chunk:
+            raise ConnectionError("closed")
+        data += chunk
+    return data
+
+
+def read_frame(conn: socket.socket):
+    first, second = recv_exact(conn, 2)
+    opcode = first & 0x0F
+    length = second & 0x7F
+    if length == 126:
+        length = struct.unpack(">H", recv_exact(conn, 2))[0]
+    elif length == 127:
+        length = struct.unpack(">Q", recv_exact(conn, 8))[0]
+    mask = recv_exact(conn, 4) if second & 0x80 else b"\0\0\0\0"
+    payload = bytes(b ^ mask[i % 4] for i, b in enumerate(recv_exact(conn, length)))
+    return opcode, payload
+
+
+def send_frame(conn: socket.socket, payload: bytes, opcode: int = 1) -> None:
+    header = bytes([0x80 | opcode])
+    if len(payload) < 126:
+        header += bytes([len(payload)])
+    elif len(payload) < 65536:
+        header += bytes([126]) + struct.pack(">H", len(payload))
+    else:
+        header += bytes([127]) + struct.pack(">Q", len(payload))
+    conn.sendall(header + payload)
+
+
+def send_json(conn: socket.socket, message: dict) -> None:
+    send_frame(conn, json.dumps(message).encode())
+
+
+def serve_client(conn: socket.socket, address) -> None:
+    entry = [conn, None]
+    try:
+        if not handshake(conn):
+            return
+        log("%s:%d connected" % address)
+        with clients_lock:
+            clients.append(entry)
+
+        while True:
+            opcode, payload = read_frame(conn)
+            if opcode == 8:
+                break
+            if opcode == 9:
+                send_frame(conn, payload, 10)
+                continue
+            if opcode != 1:
+                continue
+
+            message = json.loads(payload)
+            topic, event = message.get("topic"), message.get("event")
+            if event == "phx_join":
+                entry[1] = topic
+                log("joined %s" % topic)
+            elif event != "heartbeat":
+                log("unexpected %s on %s" % (event, topic))
+            send_json(conn, {"topic": topic, "event": "phx_reply", "ref": message.get("ref"),
+                             "payload": {"status": "ok", "response": {}}})
+    except (ConnectionError, OSError, ValueError) as error:
+        log("%s:%d dropped (%s)" % (address[0], address[1], error))
+    finally:
+        with clients_lock:
+            if entry in clients:
+                clients.remove(entry)
+        conn.close()
+        log("%s:%d disconnected" % address)
+
+
+def announce(command_id: str) -> None:
+    with clients_lock:
+        targets = [(conn, topic) for conn, topic in clients if topic]
+    if not targets:
+        log("no device joined yet")
+    for conn, topic in targets:
+        send_json(conn, {"topic": topic, "event": "broadcast", "ref": None,
+                         "payload": {"type": "broadcast", "event": "command",
+                                     "payload": {"id": command_id}}})
+        log("announced %s on %s" % (command_id, topic))
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", type=int, default=4000)
+    parser.add_argument("--every", type=float, default=0, help="announce a random command every N seconds")
+    args = parser.parse_args()
+
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(("", args.port))
+    server.listen()
+    log("listening on port %d" % args.port)
+
+    def accept_loop():
+        while True:
+            conn, address = server.accept()
+            threading.Thread(target=serve_client, args=(conn, address), daemon=True).start()
+
+    threading.Thread(target=accept_loop, daemon=True).start()
+
+    try:
+        if args.every > 0:
+            while True:
+                time.sleep(args.every)
+                announce(str(uuid.uuid4()))
+        for line in sys.stdin:
+            announce(line.strip() or str(uuid.uuid4()))
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
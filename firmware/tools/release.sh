@@ -0,0 +1,85 @@
+#!/bin/sh
+# Build an OTA release of ESP8266 Greenhouse firmware (v3.2.0+).
+#
+# Compiles the sketch with arduino-cli, builds the OTA artifacts and the
+# firmware_versions / firmware_deltas rows with ota_artifacts.py (each hash
+# from the file it describes) into dist/<version>/manifest.json, and with
+# SUPABASE_URL and SUPABASE_SERVICE_KEY set uploads the files and inserts
+# the rows, so the stored hashes always belong to the uploaded files.
+#
+# Usage (from firmware/):
+#   tools/release.sh v3.2.1 [previous.bin previous-version]
+# Environment:
+#   FQBN                  board (default esp8266:esp8266:d1_mini)
+#   SKETCH                sketch directory (default ESP8266_Greenhouse_v3.2.0)
+#   SUPABASE_URL          project URL; with the key below: publish
+#   SUPABASE_SERVICE_KEY  service role key (storage upload, table insert)
+
+set -e
+
+VERSION=$1
+BASE_BIN=$2
+BASE_VERSION=$3
+if [ -z "$VERSION" ] || { [ -n "$BASE_BIN" ] && [ -z "$BASE_VERSION" ]; }; then
+  echo "usage: $0 <version> [previous.bin previous-version]" >&2
+  exit 1
+fi
+
+FQBN=${FQBN:-esp8266:esp8266:d1_mini}
+SKETCH=${SKETCH:-ESP8266_Greenhouse_v3.2.0}
+TOOLS=$(dirname "$0")
+OUT=dist/$VERSION
+
+mkdir -p "$OUT/build"
+arduino-cli compile --fqbn "$FQBN" --export-binaries --output-dir "$OUT/build" "$SKETCH"
+IMAGE=$OUT/build/$(basename "$SKETCH").ino.bin
+cp "$IMAGE" "$OUT/firmware-$VERSION.bin"
+
+if [ -n "$BASE_BIN" ]; then
+  python3 "$TOOLS/ota_artifacts.py" "$OUT/firmware-$VERSION.bin" --version "$VERSION" \
+    --base "$BASE_BIN" --base-version "$BASE_VERSION" --out "$OUT" > "$OUT/manifest.json"
+else
+  python3 "$TOOLS/ota_artifacts.py" "$OUT/firmware-$VERSION.bin" --version "$VERSION" \
+    --out "$OUT" > "$OUT/manifest.json"
+fi
+echo "Manifest: $OUT/manifest.json"
+
+if [ -z "$SUPABASE_URL" ] || [ -z "$SUPABASE_SERVICE_KEY" ]; then
+  echo "SUPABASE_URL / SUPABASE_SERVICE_KEY not set: upload the files listed under"
+  echo "\"upload\" to their storage_path and insert \"rows\" by hand."
+  exit 0
+fi
+
+# manifest value by path, e.g. field rows/firmware_versions/storage_path
+field() {
+  python3 -c 'import json,sys; v=json.load(open(sys.argv[1]))
+for k in sys.argv[2].split("/"): v=v[k]
+print(v if not isinstance(v, dict) else json.dumps(v))' "$OUT/manifest.json" "$1"
+}
+
+upload() {
+  curl -sf -X POST "$SUPABASE_URL/storage/v1/object/$2" \
+    -H "Authorization: Bearer $SUPABASE_SERVICE_KEY" \
+    -H "Content-Type: application/octet-stream" --data-binary "@$1" > /dev/null
+  echo "Uploaded $2"
+}
+
+insert() {
+  curl -sf -X POST "$SUPABASE_URL/rest/v1/$1" \
+    -H "apikey: $SUPABASE_SERVICE_KEY" -H "Authorization: Bearer $SUPABASE_SERVICE_KEY" \
+    -H "Content-Type: application/json" -H "Prefer: return=representation" -d "$2"
+}
+
+UPLOAD_NAME=$(basename "$(field rows/firmware_versions/storage_path)")
+upload "$(field "upload/$UPLOAD_NAME")" "$(field rows/firmware_versions/storage_path)"
+VERSION_ID=$(insert firmware_versions "$(field rows/firmware_versions)" |
+  python3 -c 'import json,sys; print(json.load(sys.stdin)[0]["id"])')
+echo "firmware_versions $VERSION_ID"
+
+if [ -n "$BASE_BIN" ]; then
+  DELTA_NAME=$(basename "$(field rows/firmware_deltas/storage_path)")
+  upload "$(field "upload/$DELTA_NAME")" "$(field rows/firmware_deltas/storage_path)"
+  insert firmware_deltas "$(field rows/firmware_deltas | python3 -c 'import json,sys
+row=json.load(sys.stdin); row["firmware_version_id"]=sys.argv[1]; print(json.dumps(row))' "$VERSION_ID")" > /dev/null
+  echo "firmware_deltas from $BASE_VERSION"
+fi
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""
+Build the gzip-compressed web UI header for ESP8266 Greenhouse v3.2.0.
+
+Reads the static files in <sketch>/webui/ and writes <sketch>/webui_assets.h
+with one PROGMEM array per file, served as-is with Content-Encoding: gzip
+(webserver.cpp). CSS/JS get the content hash in their URL so they can be
+cached for a year; HTML pages are revalidated with their ETag.
+
+Run after editing anything in webui/ and commit the generated header
+(the Arduino IDE does not run build scripts):
+  python3 webui_assets.py ../ESP8266_Greenhouse_v3.2.0
+"""
+
+import argparse
+import gzip
+import hashlib
+import os
+import sys
+
+# file name -> (URL path, content type); HTML pages are routed by path
+PAGES = {
+    "index.html": ("/", "text/html"),
+    "config.html": ("/config", "text/html"),
+}
+STATIC = {
+    "style.css": "text/css",
+    "app.js": "application/javascript",
+}
+
+
+def c_name(file_name: str) -> str:
+    return "WEBUI_" + file_name.upper().replace(".", "_").replace("-", "_")
+
+
+def c_array(name: str, data: bytes) -> str:
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "static const uint8_t %s[] PROGMEM = {\n%s\n};\n" % (name, "\n".join(lines))
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("sketch", help="sketch directory containing webui/")
+    args = parser.parse_args()
+
+    source = os.path.join(args.sketch, "webui")
+    assets = []   # (path, content type, array name, gzip bytes, immutable, etag)
+    renames = {}
+
+    for file_name, content_type in STATIC.items():
+        with open(os.path.join(source, file_name), "rb") as f:
+            data = f.read()
+        digest = hashlib.sha256(data).hexdigest()[:8]
+        stem, ext = os.path.splitext(file_name)
+        path = "/%s.%s%s" % (stem, digest, ext)
+        renames[file_name] = path
+        assets.append((path, content_type, c_name(file_name), data, True, digest))
+
+    for file_name, (path, content_type) in PAGES.items():
+        with open(os.path.join(source, file_name), "r", encoding="utf-8") as f:
+            html = f.read()
+        for original, hashed in renames.items():
+            html = html.replace('"%s"' % original, '"%s"' % hashed)
+        data = html.encode("utf-8")
+        digest = hashlib.sha256(data).hexdigest()[:8]
+        assets.append((path, content_type, c_name(file_name), data, False, digest))
+
+    out = [
+        "// Generated by firmware/tools/webui_assets.py from webui/ - do not edit",
+        "#ifndef WEBUI_ASSETS_H",
+        "#define WEBUI_ASSETS_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "// Static web UI file, gzip-compressed in flash",
+        "struct WebAsset {",
+        "  const char* path;",
+        "  const char* contentType;",
+        "  const uint8_t* data;",
+        "  size_t length;",
+        "  bool immutable;       // Hashed URL: cache for a year",
+        "  const char* etag;",
+        "};",
+        "",
+    ]
+
+    total_raw = total_gz = 0
+    for path, content_type, name, data, immutable, digest in assets:
+        compressed = gzip.compress(data, compresslevel=9, mtime=0)
+        total_raw += len(data)
+        total_gz += len(compressed)
+        out.append("// %s: %d bytes, %d gzip" % (path, len(data), len(compressed)))
+        out.append(c_array(name, compressed))
+
+    out.append("static const WebAsset webAssets[] = {")
+    for path, content_type, name, data, immutable, digest in assets:
+        out.append('  {"%s", "%s", %s, sizeof(%s), %s, "\\"%s\\""},'
+                   % (path, content_type, name, name, "true" if immutable else "false", digest))
+    out.append("};")
+    out.append("")
+    out.append("#define WEB_ASSET_COUNT (sizeof(webAssets) / sizeof(webAssets[0]))")
+    out.append("")
+    out.append("#endif")
+
+    target = os.path.join(args.sketch, "webui_assets.h")
+    with open(target, "w", encoding="utf-8") as f:
+        f.write("\n".join(out) + "\n")
+
+    print("%s: %d files, %d -> %d bytes" % (target, len(assets), total_raw, total_gz))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
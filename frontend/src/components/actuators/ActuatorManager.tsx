@@ -18,8 +18,21 @@ interface Actuator {
   supports_pwm: boolean;
   discovered_at: string;
   is_active: boolean;
+  // Reported by v3.2.0 devices with each heartbeat
+  output_percent: number | null;
+  remaining_s: number | null;
+  manual_hold: boolean;
+  safety_tripped: boolean;
+  state_reported_at: string | null;
 }
 
+// Device-reported output wins over current_state when available
+const isActuatorOn = (actuator: Actuator): boolean =>
+  actuator.state_reported_at ? (actuator.output_percent ?? 0) > 0 : actuator.current_state > 0;
+
+const formatRemaining = (seconds: number): string =>
+  seconds >= 60 ? `${Math.floor(seconds / 60)} min ${seconds % 60} s` : `${seconds} s`;
+
 interface GroupedActuators {
   device: Device;
   actuators: Actuator[];
@@ -150,12 +163,31 @@ export const ActuatorManager: React.FC = () => {
                             </span>
                           )}
                           <span className={`text-xs px-2 py-0.5 rounded ${
-                            actuator.current_state > 0
+                            isActuatorOn(actuator)
                               ? 'bg-green-100 text-green-700'
                               : 'bg-gray-100 text-gray-700'
                           }`}>
-                            {actuator.current_state > 0 ? 'ON' : 'OFF'}
+                            {isActuatorOn(actuator)
+                              ? actuator.supports_pwm && actuator.output_percent !== null
+                                ? `ON ${actuator.output_percent}%`
+                                : 'ON'
+                              : 'OFF'}
                           </span>
+                          {isActuatorOn(actuator) && actuator.remaining_s !== null && (
+                            <span className="text-xs text-gray-500">
+                              Spegnimento tra {formatRemaining(actuator.remaining_s)}
+                            </span>
+                          )}
+                          {actuator.manual_hold && (
+                            <span className="text-xs bg-yellow-100 text-yellow-700 px-2 py-0.5 rounded">
+                              Manuale
+                            </span>
+                          )}
+                          {actuator.safety_tripped && (
+                            <span className="text-xs bg-red-100 text-red-700 px-2 py-0.5 rounded">
+                              Blocco sicurezza
+                            </span>
+                          )}
                         </div>
                       </div>
                     </div>
@@ -56,6 +56,11 @@ function getCommandTypeLabel(type: string): string {
       return 'Aggiornamento WiFi';
     case 'firmware_update':
       return 'Aggiornamento Firmware';
+    case 'relay_no':
+    case 'relay_nc':
+      return 'Relè';
+    case 'pwm':
+      return 'PWM';
     default:
       return type;
   }
@@ -116,12 +121,22 @@ export function DeviceRemoteControl({
   };
 
   // Handle firmware update
-  const handleFirmwareUpdate = async (version: string, url: string) => {
+  const handleFirmwareUpdate = async (
+    firmwareVersionId: string,
+    version: string,
+    url: string,
+    sha256: string,
+    imageSha256: string | null
+  ) => {
     try {
       await sendFirmwareUpdate.mutateAsync({
         deviceId,
         version,
         url,
+        sha256,
+        imageSha256,
+        firmwareVersionId,
+        currentVersion: currentFirmwareVersion,
       });
       setShowOTAModal(false);
     } catch (error) {
@@ -210,6 +225,9 @@ export function DeviceRemoteControl({
                 <div className="flex items-center space-x-3">
                   <span className="text-sm font-medium">{getCommandTypeLabel(cmd.command_type)}</span>
                   <CommandStatusBadge status={cmd.status} />
+                  {cmd.status === 'delivered' && cmd.progress !== null && (
+                    <span className="text-xs text-gray-500">{cmd.progress}%</span>
+                  )}
                 </div>
                 <div className="flex items-center space-x-2">
                   <span className="text-xs text-gray-500">
@@ -400,12 +418,17 @@ export function DeviceRemoteControl({
                         {!isCurrent && (
                           <button
                             onClick={() =>
+                              fw.checksum_sha256 &&
                               handleFirmwareUpdate(
+                                fw.id,
                                 fw.version,
-                                `${import.meta.env.VITE_SUPABASE_URL}/storage/v1/object/public/${fw.storage_path}`
+                                `${import.meta.env.VITE_SUPABASE_URL}/storage/v1/object/public/${fw.storage_path}`,
+                                fw.checksum_sha256,
+                                fw.image_sha256
                               )
                             }
-                            disabled={sendFirmwareUpdate.isPending}
+                            disabled={sendFirmwareUpdate.isPending || !fw.checksum_sha256}
+                            title={fw.checksum_sha256 ? undefined : 'Checksum SHA-256 mancante'}
                             className="flex items-center space-x-1 px-3 py-1.5 bg-green-600 text-white rounded-md hover:bg-green-700 disabled:opacity-50 text-sm"
                           >
                             {sendFirmwareUpdate.isPending ? (
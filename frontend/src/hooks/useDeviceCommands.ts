@@ -2,7 +2,13 @@ import { useMutation, useQuery, useQueryClient } from '@tanstack/react-query';
 import { supabase } from '../lib/supabase';
 
 // Command types
-export type DeviceCommandType = 'reset' | 'wifi_update' | 'firmware_update';
+export type DeviceCommandType =
+  | 'reset'
+  | 'wifi_update'
+  | 'firmware_update'
+  | 'relay_no'
+  | 'relay_nc'
+  | 'pwm';
 
 // Payload types
 export interface WiFiUpdatePayload {
@@ -13,6 +19,23 @@ export interface WiFiUpdatePayload {
 export interface FirmwareUpdatePayload {
   version: string;
   url: string;
+  sha256: string;         // File at url (.bin or .bin.gz)
+  image_sha256?: string;  // Uncompressed image, matched against LAN peers
+  delta_url?: string;
+  delta_sha256?: string;
+  delta_base_md5?: string;
+}
+
+// relay_no / relay_nc
+export interface RelayPayload {
+  actuator_id: string;
+  on: boolean;
+}
+
+// pwm (value in %, 0-100)
+export interface PwmPayload {
+  actuator_id: string;
+  value: number;
 }
 
 // Command status
@@ -26,6 +49,10 @@ export interface DeviceCommand {
   payload: Record<string, unknown>;
   status: CommandStatus;
   error_message: string | null;
+  progress: number | null;
+  download_bytes: number | null;
+  download_ms: number | null;
+  download_kind: 'full' | 'delta' | 'lan' | null;
   created_at: string;
   delivered_at: string | null;
   executed_at: string | null;
@@ -39,12 +66,26 @@ export interface FirmwareVersion {
   storage_path: string;
   file_size: number | null;
   checksum_md5: string | null;
+  checksum_sha256: string | null;   // File at storage_path (.bin or .bin.gz)
+  image_sha256: string | null;      // Uncompressed image the device runs
   release_notes: string | null;
   is_stable: boolean;
   is_latest: boolean;
   created_at: string;
 }
 
+// Binary delta between two firmware releases
+export interface FirmwareDelta {
+  id: string;
+  firmware_version_id: string;
+  base_version: string;
+  base_md5: string;
+  storage_path: string;
+  file_size: number | null;
+  target_sha256: string;
+  created_at: string;
+}
+
 /**
  * Hook to get pending commands for a device
  */
@@ -140,17 +181,46 @@ export function useSendFirmwareUpdateCommand() {
       deviceId,
       version,
       url,
+      sha256,
+      imageSha256,
+      firmwareVersionId,
+      currentVersion,
     }: {
       deviceId: string;
       version: string;
       url: string;
+      sha256: string;
+      imageSha256: string | null;
+      firmwareVersionId: string;
+      currentVersion: string | null;
     }) => {
+      const payload: FirmwareUpdatePayload = { version, url, sha256 };
+      if (imageSha256) payload.image_sha256 = imageSha256;
+
+      // Offer a delta patch from the installed version when one exists,
+      // the device falls back to the full image if it does not apply
+      if (currentVersion) {
+        const { data: delta } = await supabase
+          .from('firmware_deltas')
+          .select('*')
+          .eq('firmware_version_id', firmwareVersionId)
+          .eq('base_version', currentVersion)
+          .maybeSingle();
+
+        if (delta) {
+          const fw = delta as FirmwareDelta;
+          payload.delta_url = `${import.meta.env.VITE_SUPABASE_URL}/storage/v1/object/public/${fw.storage_path}`;
+          payload.delta_sha256 = fw.target_sha256;
+          payload.delta_base_md5 = fw.base_md5;
+        }
+      }
+
       const { data, error } = await supabase
         .from('device_commands')
         .insert({
           device_id: deviceId,
           command_type: 'firmware_update',
-          payload: { version, url },
+          payload,
         })
         .select()
         .single();
@@ -140,6 +140,12 @@ export type Database = {
           supports_pwm: boolean;
           discovered_at: string;
           is_active: boolean;
+          max_on_s: number;
+          output_percent: number | null;
+          remaining_s: number | null;
+          manual_hold: boolean;
+          safety_tripped: boolean;
+          state_reported_at: string | null;
         };
         Insert: {
           id?: string;
@@ -0,0 +1,56 @@
+-- =====================================================
+-- Migration: Push new device commands over Supabase Realtime
+-- Date: 2025-11-21
+-- Firmware: ESP8266 v3.2.0 (realtime.cpp)
+-- =====================================================
+
+-- =====================================================
+-- Function: broadcast_device_command
+-- Purpose: Broadcast each new command on topic "device:<composite_device_id>"
+--          so the device can execute it without waiting for its next heartbeat
+-- Payload: {id, type, payload} (same shape as heartbeat v3 commands)
+-- Note: heartbeat polling still delivers the command if the device is not
+--       subscribed; duplicates are skipped on the device by command id
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.broadcast_device_command()
+RETURNS TRIGGER
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_composite_device_id TEXT;
+BEGIN
+  SELECT composite_device_id INTO v_composite_device_id
+  FROM public.devices
+  WHERE id = NEW.device_id;
+
+  IF v_composite_device_id IS NULL THEN
+    RETURN NEW;
+  END IF;
+
+  PERFORM realtime.send(
+    jsonb_build_object(
+      'id', NEW.id,
+      'type', NEW.command_type,
+      'payload', NEW.payload
+    ),
+    'command',
+    'device:' || v_composite_device_id,
+    false
+  );
+
+  RETURN NEW;
+END;
+$$;
+
+DROP TRIGGER IF EXISTS trigger_broadcast_device_command ON public.device_commands;
+
+CREATE TRIGGER trigger_broadcast_device_command
+  AFTER INSERT ON public.device_commands
+  FOR EACH ROW
+  EXECUTE FUNCTION public.broadcast_device_command();
+
+COMMENT ON FUNCTION public.broadcast_device_command IS
+  'Trigger function that pushes new device_commands rows to the device Realtime channel for sub-second delivery';
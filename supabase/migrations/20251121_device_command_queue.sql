@@ -0,0 +1,143 @@
+-- =====================================================
+-- Migration: Multi-command heartbeat + batched command acknowledgements
+-- Date: 2025-11-21
+-- Firmware: ESP8266 v3.2.0 (command queue)
+-- =====================================================
+
+-- =====================================================
+-- Function: device_heartbeat_with_config_v3
+-- Purpose: Heartbeat that returns up to max_commands_param pending commands
+-- Returns: {success, device_id, config_version, commands: [{id, type, payload}], timestamp}
+-- Note: commands stay re-deliverable (status 'delivered') until acknowledged,
+--       so a device that restarts mid-queue receives the rest on next heartbeat
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.device_heartbeat_with_config_v3(
+  composite_device_id_param text,
+  firmware_version_param text DEFAULT NULL,
+  max_commands_param integer DEFAULT 4
+)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  v_config_version INTEGER;
+  v_commands JSON;
+  v_command_ids UUID[];
+  result JSON;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id, config_version INTO v_device_id, v_config_version
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  -- Update last_seen_at (and optionally firmware_version)
+  UPDATE public.devices
+  SET last_seen_at = NOW(),
+      firmware_version = COALESCE(firmware_version_param, firmware_version)
+  WHERE id = v_device_id;
+
+  -- Oldest pending/unacknowledged commands first, bounded by device queue space
+  SELECT
+    COALESCE(json_agg(json_build_object(
+      'id', c.id,
+      'type', c.command_type,
+      'payload', c.payload
+    ) ORDER BY c.created_at), '[]'::json),
+    array_agg(c.id)
+  INTO v_commands, v_command_ids
+  FROM (
+    SELECT id, command_type, payload, created_at
+    FROM public.device_commands
+    WHERE device_id = v_device_id
+      AND status IN ('pending', 'delivered')
+      AND (expires_at IS NULL OR expires_at > NOW())
+    ORDER BY created_at ASC
+    LIMIT GREATEST(LEAST(max_commands_param, 10), 0)
+  ) c;
+
+  -- Mark as delivered
+  IF v_command_ids IS NOT NULL THEN
+    UPDATE public.device_commands
+    SET status = 'delivered',
+        delivered_at = COALESCE(delivered_at, NOW())
+    WHERE id = ANY(v_command_ids);
+  END IF;
+
+  SELECT json_build_object(
+    'success', true,
+    'device_id', v_device_id,
+    'composite_device_id', composite_device_id_param,
+    'config_version', v_config_version,
+    'commands', v_commands,
+    'timestamp', NOW()
+  ) INTO result;
+
+  RETURN result;
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.device_heartbeat_with_config_v3(text, text, integer) TO authenticated, anon;
+
+COMMENT ON FUNCTION public.device_heartbeat_with_config_v3 IS
+  'Heartbeat returning config_version and a bounded array of pending commands. Commands remain re-deliverable until acknowledged';
+
+-- =====================================================
+-- Function: acknowledge_device_commands
+-- Purpose: Record results of several commands in a single request
+-- Params: acks_param = [{command_id, success, error_message?}]
+-- Returns: {success, acknowledged}
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.acknowledge_device_commands(
+  composite_device_id_param text,
+  acks_param jsonb
+)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  v_count INTEGER;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id INTO v_device_id
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  -- Only commands of this device that are still open can be acknowledged
+  UPDATE public.device_commands c
+  SET status = CASE WHEN (a.ack->>'success')::boolean THEN 'executed' ELSE 'failed' END,
+      error_message = a.ack->>'error_message',
+      executed_at = NOW()
+  FROM jsonb_array_elements(acks_param) AS a(ack)
+  WHERE c.id = (a.ack->>'command_id')::uuid
+    AND c.device_id = v_device_id
+    AND c.status IN ('pending', 'delivered');
+
+  GET DIAGNOSTICS v_count = ROW_COUNT;
+
+  RETURN json_build_object(
+    'success', true,
+    'acknowledged', v_count
+  );
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.acknowledge_device_commands(text, jsonb) TO authenticated, anon;
+
+COMMENT ON FUNCTION public.acknowledge_device_commands IS
+  'Batched command acknowledgement used by ESP8266 v3.2.0 command queue';
@@ -0,0 +1,87 @@
+-- =====================================================
+-- Migration: OTA progress reporting + SHA-256 image checksums
+-- Date: 2025-11-22
+-- Firmware: ESP8266 v3.2.0 (ota.cpp streaming OTA)
+-- =====================================================
+
+-- =====================================================
+-- SHA-256 of firmware images (sent in firmware_update payload)
+-- =====================================================
+
+ALTER TABLE public.firmware_versions
+ADD COLUMN IF NOT EXISTS checksum_sha256 TEXT;
+
+COMMENT ON COLUMN public.firmware_versions.checksum_sha256 IS
+  'Hex SHA-256 of the firmware image. Device verifies it before committing an OTA update';
+
+-- =====================================================
+-- Progress of long running commands (OTA download percentage)
+-- =====================================================
+
+ALTER TABLE public.device_commands
+ADD COLUMN IF NOT EXISTS progress SMALLINT;
+
+COMMENT ON COLUMN public.device_commands.progress IS
+  'Execution progress in percent reported by the device (e.g. OTA download)';
+
+-- =====================================================
+-- Function: acknowledge_device_commands (progress support)
+-- Params: acks_param = [{command_id, success, error_message?}
+--                      | {command_id, progress}]
+-- Progress entries only update progress, the command stays open
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.acknowledge_device_commands(
+  composite_device_id_param text,
+  acks_param jsonb
+)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  v_count INTEGER;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id INTO v_device_id
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  -- Progress reports
+  UPDATE public.device_commands c
+  SET progress = LEAST(GREATEST((a.ack->>'progress')::integer, 0), 100)
+  FROM jsonb_array_elements(acks_param) AS a(ack)
+  WHERE a.ack ? 'progress'
+    AND NOT a.ack ? 'success'
+    AND c.id = (a.ack->>'command_id')::uuid
+    AND c.device_id = v_device_id
+    AND c.status IN ('pending', 'delivered');
+
+  -- Final results: only commands of this device that are still open
+  UPDATE public.device_commands c
+  SET status = CASE WHEN (a.ack->>'success')::boolean THEN 'executed' ELSE 'failed' END,
+      error_message = a.ack->>'error_message',
+      progress = CASE WHEN (a.ack->>'success')::boolean THEN 100 ELSE c.progress END,
+      executed_at = NOW()
+  FROM jsonb_array_elements(acks_param) AS a(ack)
+  WHERE a.ack ? 'success'
+    AND c.id = (a.ack->>'command_id')::uuid
+    AND c.device_id = v_device_id
+    AND c.status IN ('pending', 'delivered');
+
+  GET DIAGNOSTICS v_count = ROW_COUNT;
+
+  RETURN json_build_object(
+    'success', true,
+    'acknowledged', v_count
+  );
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.acknowledge_device_commands(text, jsonb) TO authenticated, anon;
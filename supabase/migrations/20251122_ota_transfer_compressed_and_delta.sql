@@ -0,0 +1,119 @@
+-- =====================================================
+-- Migration: Compressed and delta OTA images + download metrics
+-- Date: 2025-11-22
+-- Firmware: ESP8266 v3.2.0 (ota.cpp), artifacts from firmware/tools/ota_artifacts.py
+-- =====================================================
+
+-- =====================================================
+-- Table: firmware_deltas
+-- Purpose: Binary patches from a base release to a firmware version.
+--          Device applies the patch only if its running image MD5 equals
+--          base_md5, otherwise it downloads the full image.
+-- =====================================================
+
+CREATE TABLE IF NOT EXISTS public.firmware_deltas (
+  id UUID PRIMARY KEY DEFAULT gen_random_uuid(),
+  firmware_version_id UUID NOT NULL REFERENCES public.firmware_versions(id) ON DELETE CASCADE,
+  base_version TEXT NOT NULL,
+  base_md5 TEXT NOT NULL,
+  storage_path TEXT NOT NULL,
+  file_size INTEGER,
+  target_sha256 TEXT NOT NULL,
+  created_at TIMESTAMPTZ DEFAULT NOW() NOT NULL,
+  UNIQUE (firmware_version_id, base_version)
+);
+
+ALTER TABLE public.firmware_deltas ENABLE ROW LEVEL SECURITY;
+
+DROP POLICY IF EXISTS "Authenticated users can read firmware deltas" ON public.firmware_deltas;
+CREATE POLICY "Authenticated users can read firmware deltas"
+  ON public.firmware_deltas FOR SELECT
+  TO authenticated
+  USING (true);
+
+COMMENT ON TABLE public.firmware_deltas IS
+  'Binary delta patches between firmware releases, sent as delta_url in firmware_update commands';
+
+-- =====================================================
+-- Download metrics reported by the device for firmware updates
+-- =====================================================
+
+ALTER TABLE public.device_commands
+ADD COLUMN IF NOT EXISTS download_bytes INTEGER,
+ADD COLUMN IF NOT EXISTS download_ms INTEGER,
+ADD COLUMN IF NOT EXISTS download_kind TEXT;
+
+COMMENT ON COLUMN public.device_commands.download_bytes IS
+  'Bytes downloaded by the device for a firmware_update (full, gzip or delta artifact)';
+
+-- =====================================================
+-- Function: acknowledge_device_commands (metrics support)
+-- Params: acks_param = [{command_id, success, error_message?}
+--                      | {command_id, progress}
+--                      | {command_id, download_bytes, download_ms, download_kind}]
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.acknowledge_device_commands(
+  composite_device_id_param text,
+  acks_param jsonb
+)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  v_count INTEGER;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id INTO v_device_id
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  -- Progress reports
+  UPDATE public.device_commands c
+  SET progress = LEAST(GREATEST((a.ack->>'progress')::integer, 0), 100)
+  FROM jsonb_array_elements(acks_param) AS a(ack)
+  WHERE a.ack ? 'progress'
+    AND NOT a.ack ? 'success'
+    AND c.id = (a.ack->>'command_id')::uuid
+    AND c.device_id = v_device_id
+    AND c.status IN ('pending', 'delivered');
+
+  -- Download metrics
+  UPDATE public.device_commands c
+  SET download_bytes = (a.ack->>'download_bytes')::integer,
+      download_ms = (a.ack->>'download_ms')::integer,
+      download_kind = a.ack->>'download_kind'
+  FROM jsonb_array_elements(acks_param) AS a(ack)
+  WHERE a.ack ? 'download_bytes'
+    AND c.id = (a.ack->>'command_id')::uuid
+    AND c.device_id = v_device_id;
+
+  -- Final results: only commands of this device that are still open
+  UPDATE public.device_commands c
+  SET status = CASE WHEN (a.ack->>'success')::boolean THEN 'executed' ELSE 'failed' END,
+      error_message = a.ack->>'error_message',
+      progress = CASE WHEN (a.ack->>'success')::boolean THEN 100 ELSE c.progress END,
+      executed_at = NOW()
+  FROM jsonb_array_elements(acks_param) AS a(ack)
+  WHERE a.ack ? 'success'
+    AND c.id = (a.ack->>'command_id')::uuid
+    AND c.device_id = v_device_id
+    AND c.status IN ('pending', 'delivered');
+
+  GET DIAGNOSTICS v_count = ROW_COUNT;
+
+  RETURN json_build_object(
+    'success', true,
+    'acknowledged', v_count
+  );
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.acknowledge_device_commands(text, jsonb) TO authenticated, anon;
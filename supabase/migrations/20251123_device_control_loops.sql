@@ -0,0 +1,116 @@
+-- =====================================================
+-- Migration: Local control loops (hysteresis / PID) with cloud setpoints
+-- Date: 2025-11-23
+-- Firmware: ESP8266 v3.2.0 (control.cpp)
+-- =====================================================
+
+-- =====================================================
+-- Table: device_control_loops
+-- Purpose: One closed loop per actuator, executed on the device from local
+--          sensor readings. The cloud only delivers setpoints and gains.
+-- =====================================================
+
+CREATE TABLE IF NOT EXISTS public.device_control_loops (
+  id UUID PRIMARY KEY DEFAULT uuid_generate_v4(),
+  device_id UUID NOT NULL REFERENCES public.devices(id) ON DELETE CASCADE,
+  actuator_id TEXT NOT NULL CHECK (char_length(actuator_id) <= 15),
+  actuator_type TEXT NOT NULL CHECK (actuator_type IN ('relay_no', 'relay_nc', 'pwm')),
+  port_id TEXT NOT NULL CHECK (port_id ~ '^[A-Za-z0-9_-]+$' AND char_length(port_id) <= 50),
+  sensor_type TEXT NOT NULL,
+  mode TEXT NOT NULL DEFAULT 'hysteresis' CHECK (mode IN ('hysteresis', 'pid')),
+  cooling BOOLEAN NOT NULL DEFAULT FALSE,
+  setpoint REAL NOT NULL,
+  hysteresis REAL NOT NULL DEFAULT 1.0 CHECK (hysteresis >= 0),
+  kp REAL NOT NULL DEFAULT 0,
+  ki REAL NOT NULL DEFAULT 0,
+  kd REAL NOT NULL DEFAULT 0,
+  is_active BOOLEAN DEFAULT TRUE NOT NULL,
+  updated_at TIMESTAMPTZ DEFAULT NOW() NOT NULL,
+  CONSTRAINT device_control_loops_unique_actuator UNIQUE (device_id, actuator_id),
+  CONSTRAINT device_control_loops_pid_pwm CHECK (mode <> 'pid' OR actuator_type = 'pwm')
+);
+
+CREATE INDEX IF NOT EXISTS idx_device_control_loops_device_id
+  ON public.device_control_loops(device_id);
+
+ALTER TABLE public.device_control_loops ENABLE ROW LEVEL SECURITY;
+
+CREATE POLICY "Users can manage control loops of their devices"
+  ON public.device_control_loops FOR ALL
+  USING (
+    EXISTS (
+      SELECT 1 FROM public.devices d
+      WHERE d.id = device_control_loops.device_id
+        AND d.user_id = auth.uid()
+    )
+  );
+
+COMMENT ON TABLE public.device_control_loops IS
+  'Local control loops executed on the device. cooling = output lowers the input (fans); PID requires a pwm actuator';
+
+-- Setpoint changes reach the device through the existing config_version sync
+DROP TRIGGER IF EXISTS trigger_increment_config_version_control ON public.device_control_loops;
+
+CREATE TRIGGER trigger_increment_config_version_control
+  AFTER INSERT OR UPDATE OR DELETE ON public.device_control_loops
+  FOR EACH ROW
+  EXECUTE FUNCTION public.increment_device_config_version();
+
+-- =====================================================
+-- Function: get_device_control_config
+-- Purpose: Return active control loops for a device (fetched together with
+--          get_device_sensor_config when config_version changes)
+-- Returns: JSON array of {actuator_id, actuator_type, port_id, sensor_type,
+--          mode, cooling, setpoint, hysteresis, kp, ki, kd}
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.get_device_control_config(composite_device_id_param text)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  result JSON;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id INTO v_device_id
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'actuator_type', actuator_type,
+        'port_id', port_id,
+        'sensor_type', sensor_type,
+        'mode', mode,
+        'cooling', cooling,
+        'setpoint', setpoint,
+        'hysteresis', hysteresis,
+        'kp', kp,
+        'ki', ki,
+        'kd', kd
+      )
+      ORDER BY actuator_id
+    ),
+    '[]'::json
+  ) INTO result
+  FROM public.device_control_loops
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  RETURN result;
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.get_device_control_config(text) TO authenticated, anon;
+
+COMMENT ON FUNCTION public.get_device_control_config IS
+  'Returns active local control loops for a device as JSON array. Called by ESP8266 v3.2.0 on config sync';
@@ -0,0 +1,127 @@
+-- =====================================================
+-- Migration: Actuator outputs for ESP8266 v3.2.0 + actuator commands
+-- Date: 2025-11-24
+-- Firmware: ESP8266 v3.2.0 (actuators.cpp)
+-- =====================================================
+
+-- =====================================================
+-- Actuator wiring on the device
+-- output_type: how the GPIO drives the load (relay_no, relay_nc, pwm)
+-- ramp_ms: PWM soft-start time from 0 to 100% (0 = immediate)
+-- =====================================================
+
+ALTER TABLE public.actuators
+ADD COLUMN IF NOT EXISTS port_id TEXT CHECK (port_id ~ '^[A-Za-z0-9_-]+$' AND char_length(port_id) <= 50),
+ADD COLUMN IF NOT EXISTS output_type TEXT CHECK (output_type IN ('relay_no', 'relay_nc', 'pwm')),
+ADD COLUMN IF NOT EXISTS ramp_ms INTEGER DEFAULT 0 NOT NULL CHECK (ramp_ms BETWEEN 0 AND 60000);
+
+COMMENT ON COLUMN public.actuators.output_type IS
+  'Device output driving the actuator: relay_no, relay_nc or pwm. NULL = not wired to a v3.2.0 device';
+
+-- Only wiring changes bump config_version (current_state updates do not)
+DROP TRIGGER IF EXISTS trigger_increment_config_version_actuators ON public.actuators;
+
+CREATE TRIGGER trigger_increment_config_version_actuators
+  AFTER INSERT OR DELETE OR UPDATE OF actuator_id, port_id, output_type, ramp_ms, is_active
+  ON public.actuators
+  FOR EACH ROW
+  EXECUTE FUNCTION public.increment_device_config_version();
+
+-- Output wiring now lives on the actuator, loops only reference it by id
+ALTER TABLE public.device_control_loops
+DROP CONSTRAINT IF EXISTS device_control_loops_pid_pwm,
+DROP COLUMN IF EXISTS actuator_type,
+DROP COLUMN IF EXISTS port_id;
+
+-- =====================================================
+-- Actuator commands on the device command channel
+-- relay_no / relay_nc: payload {actuator_id, on}
+-- pwm:                 payload {actuator_id, value: 0-100}
+-- =====================================================
+
+ALTER TABLE public.device_commands
+DROP CONSTRAINT IF EXISTS device_commands_command_type_check;
+
+ALTER TABLE public.device_commands
+ADD CONSTRAINT device_commands_command_type_check CHECK (command_type IN (
+  'reset', 'wifi_update', 'firmware_update', 'relay_no', 'relay_nc', 'pwm'
+));
+
+-- =====================================================
+-- Function: get_device_control_config (actuator table)
+-- Returns: {actuators: [{actuator_id, output_type, port_id, ramp_ms}],
+--           loops: [{actuator_id, sensor_type, mode, cooling, setpoint,
+--                    hysteresis, kp, ki, kd}]}
+-- Note: the device resolves actuator_id to a table index once per sync
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.get_device_control_config(composite_device_id_param text)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  v_actuators JSON;
+  v_loops JSON;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id INTO v_device_id
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'output_type', output_type,
+        'port_id', port_id,
+        'ramp_ms', ramp_ms
+      )
+      ORDER BY actuator_id
+    ),
+    '[]'::json
+  ) INTO v_actuators
+  FROM public.actuators
+  WHERE device_id = v_device_id
+    AND is_active = TRUE
+    AND output_type IS NOT NULL
+    AND port_id IS NOT NULL;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'sensor_type', sensor_type,
+        'mode', mode,
+        'cooling', cooling,
+        'setpoint', setpoint,
+        'hysteresis', hysteresis,
+        'kp', kp,
+        'ki', ki,
+        'kd', kd
+      )
+      ORDER BY actuator_id
+    ),
+    '[]'::json
+  ) INTO v_loops
+  FROM public.device_control_loops
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  RETURN json_build_object(
+    'actuators', v_actuators,
+    'loops', v_loops
+  );
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.get_device_control_config(text) TO authenticated, anon;
+
+COMMENT ON FUNCTION public.get_device_control_config IS
+  'Returns actuator wiring and active local control loops for a device. Called by ESP8266 v3.2.0 on config sync';
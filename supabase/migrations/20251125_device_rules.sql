@@ -0,0 +1,153 @@
+-- =====================================================
+-- Migration: On-device automation rules
+-- Date: 2025-11-25
+-- Firmware: ESP8266 v3.2.0 (rules.cpp)
+-- =====================================================
+
+-- =====================================================
+-- Table: device_rules
+-- Purpose: Conditions evaluated on the device on every sensor sample,
+--          without a cloud round trip.
+-- condition: flattened expression in postfix order, e.g.
+--   soil < 30 and hour in 6-8 ->
+--   ["soil_moisture", 30, "<", "hour", 6, ">=", "and", "hour", 8, "<", "and"]
+--   Tokens: numbers, sensor names, "output:<actuator_id>", "hour", "minute",
+--   "<", "<=", ">", ">=", "==", "!=", "and", "or", "not", "+", "-"
+-- value: actuator output in % while the rule is active
+-- duration_s: 0 = follow the condition, > 0 = pulse on each rising edge
+-- =====================================================
+
+CREATE TABLE IF NOT EXISTS public.device_rules (
+  id UUID PRIMARY KEY DEFAULT uuid_generate_v4(),
+  device_id UUID NOT NULL REFERENCES public.devices(id) ON DELETE CASCADE,
+  name TEXT NOT NULL CHECK (char_length(name) <= 100),
+  condition JSONB NOT NULL CHECK (jsonb_typeof(condition) = 'array' AND jsonb_array_length(condition) BETWEEN 1 AND 64),
+  actuator_id TEXT NOT NULL CHECK (char_length(actuator_id) <= 15),
+  value INTEGER NOT NULL DEFAULT 100 CHECK (value BETWEEN 0 AND 100),
+  duration_s INTEGER NOT NULL DEFAULT 0 CHECK (duration_s BETWEEN 0 AND 65535),
+  position INTEGER NOT NULL DEFAULT 0,
+  is_active BOOLEAN DEFAULT TRUE NOT NULL,
+  updated_at TIMESTAMPTZ DEFAULT NOW() NOT NULL
+);
+
+CREATE INDEX IF NOT EXISTS idx_device_rules_device_id
+  ON public.device_rules(device_id);
+
+ALTER TABLE public.device_rules ENABLE ROW LEVEL SECURITY;
+
+CREATE POLICY "Users can manage rules of their devices"
+  ON public.device_rules FOR ALL
+  USING (
+    EXISTS (
+      SELECT 1 FROM public.devices d
+      WHERE d.id = device_rules.device_id
+        AND d.user_id = auth.uid()
+    )
+  );
+
+COMMENT ON TABLE public.device_rules IS
+  'Automation rules compiled and executed on the device (max 8 per device). Actuators with a control loop are skipped';
+
+DROP TRIGGER IF EXISTS trigger_increment_config_version_rules ON public.device_rules;
+
+CREATE TRIGGER trigger_increment_config_version_rules
+  AFTER INSERT OR UPDATE OR DELETE ON public.device_rules
+  FOR EACH ROW
+  EXECUTE FUNCTION public.increment_device_config_version();
+
+-- =====================================================
+-- Function: get_device_control_config (with rules)
+-- Returns: {actuators: [...], loops: [...],
+--           rules: [{actuator_id, condition, value, duration_s}]}
+-- Note: get_device_sensor_config keeps returning a bare array (parsed by
+--       v3.1.x firmware), rules travel with the v3.2.0 control config
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.get_device_control_config(composite_device_id_param text)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  v_actuators JSON;
+  v_loops JSON;
+  v_rules JSON;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id INTO v_device_id
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'output_type', output_type,
+        'port_id', port_id,
+        'ramp_ms', ramp_ms
+      )
+      ORDER BY actuator_id
+    ),
+    '[]'::json
+  ) INTO v_actuators
+  FROM public.actuators
+  WHERE device_id = v_device_id
+    AND is_active = TRUE
+    AND output_type IS NOT NULL
+    AND port_id IS NOT NULL;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'sensor_type', sensor_type,
+        'mode', mode,
+        'cooling', cooling,
+        'setpoint', setpoint,
+        'hysteresis', hysteresis,
+        'kp', kp,
+        'ki', ki,
+        'kd', kd
+      )
+      ORDER BY actuator_id
+    ),
+    '[]'::json
+  ) INTO v_loops
+  FROM public.device_control_loops
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'condition', condition,
+        'value', value,
+        'duration_s', duration_s
+      )
+      ORDER BY position, updated_at
+    ),
+    '[]'::json
+  ) INTO v_rules
+  FROM public.device_rules
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  RETURN json_build_object(
+    'actuators', v_actuators,
+    'loops', v_loops,
+    'rules', v_rules
+  );
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.get_device_control_config(text) TO authenticated, anon;
+
+COMMENT ON FUNCTION public.get_device_control_config IS
+  'Returns actuator wiring, active local control loops and automation rules for a device. Called by ESP8266 v3.2.0 on config sync';
@@ -0,0 +1,173 @@
+-- =====================================================
+-- Migration: On-device schedules (irrigation timers)
+-- Date: 2025-11-27
+-- Firmware: ESP8266 v3.2.0 (schedules.cpp)
+-- =====================================================
+
+-- =====================================================
+-- Table: device_schedules
+-- Purpose: Timers executed by the device itself (no cloud job, no command
+--          round trip). Start times are device local time (Europe/Rome).
+-- weekdays: 0 = Sunday ... 6 = Saturday
+-- missed_policy: what the device does with a run missed while it was off
+--   skip     = wait for the next start
+--   resume   = if still inside the window, run for the remaining time
+--   catch_up = resume, or run the full duration if missed less than 6 h ago
+-- =====================================================
+
+CREATE TABLE IF NOT EXISTS public.device_schedules (
+  id UUID PRIMARY KEY DEFAULT uuid_generate_v4(),
+  device_id UUID NOT NULL REFERENCES public.devices(id) ON DELETE CASCADE,
+  name TEXT NOT NULL CHECK (char_length(name) <= 100),
+  actuator_id TEXT NOT NULL CHECK (char_length(actuator_id) <= 15),
+  start_time TIME NOT NULL,
+  weekdays INTEGER[] NOT NULL DEFAULT '{0,1,2,3,4,5,6}'
+    CHECK (cardinality(weekdays) BETWEEN 1 AND 7 AND weekdays <@ ARRAY[0,1,2,3,4,5,6]),
+  duration_s INTEGER NOT NULL CHECK (duration_s BETWEEN 1 AND 65535),
+  value INTEGER NOT NULL DEFAULT 100 CHECK (value BETWEEN 0 AND 100),
+  missed_policy TEXT NOT NULL DEFAULT 'skip' CHECK (missed_policy IN ('skip', 'resume', 'catch_up')),
+  is_active BOOLEAN DEFAULT TRUE NOT NULL,
+  updated_at TIMESTAMPTZ DEFAULT NOW() NOT NULL
+);
+
+CREATE INDEX IF NOT EXISTS idx_device_schedules_device_id
+  ON public.device_schedules(device_id);
+
+ALTER TABLE public.device_schedules ENABLE ROW LEVEL SECURITY;
+
+CREATE POLICY "Users can manage schedules of their devices"
+  ON public.device_schedules FOR ALL
+  USING (
+    EXISTS (
+      SELECT 1 FROM public.devices d
+      WHERE d.id = device_schedules.device_id
+        AND d.user_id = auth.uid()
+    )
+  );
+
+COMMENT ON TABLE public.device_schedules IS
+  'Timers executed on the device (max 8 per device). Actuators with a control loop are skipped';
+
+DROP TRIGGER IF EXISTS trigger_increment_config_version_schedules ON public.device_schedules;
+
+CREATE TRIGGER trigger_increment_config_version_schedules
+  AFTER INSERT OR UPDATE OR DELETE ON public.device_schedules
+  FOR EACH ROW
+  EXECUTE FUNCTION public.increment_device_config_version();
+
+-- =====================================================
+-- Function: get_device_control_config (with schedules)
+-- Returns: {actuators, loops, rules,
+--           schedules: [{actuator_id, start_s, weekdays (bit mask),
+--                        duration_s, value, missed_policy}]}
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.get_device_control_config(composite_device_id_param text)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  v_actuators JSON;
+  v_loops JSON;
+  v_rules JSON;
+  v_schedules JSON;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id INTO v_device_id
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'output_type', output_type,
+        'port_id', port_id,
+        'ramp_ms', ramp_ms
+      )
+      ORDER BY actuator_id
+    ),
+    '[]'::json
+  ) INTO v_actuators
+  FROM public.actuators
+  WHERE device_id = v_device_id
+    AND is_active = TRUE
+    AND output_type IS NOT NULL
+    AND port_id IS NOT NULL;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'sensor_type', sensor_type,
+        'mode', mode,
+        'cooling', cooling,
+        'setpoint', setpoint,
+        'hysteresis', hysteresis,
+        'kp', kp,
+        'ki', ki,
+        'kd', kd
+      )
+      ORDER BY actuator_id
+    ),
+    '[]'::json
+  ) INTO v_loops
+  FROM public.device_control_loops
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'condition', condition,
+        'value', value,
+        'duration_s', duration_s
+      )
+      ORDER BY position, updated_at
+    ),
+    '[]'::json
+  ) INTO v_rules
+  FROM public.device_rules
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  -- weekdays INT[] (0 = Sunday) -> bit mask, start_time -> seconds after midnight
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'start_s', EXTRACT(EPOCH FROM start_time)::INTEGER,
+        'weekdays', (SELECT COALESCE(SUM(1 << d), 0) FROM unnest(weekdays) AS d),
+        'duration_s', duration_s,
+        'value', value,
+        'missed_policy', missed_policy
+      )
+      ORDER BY start_time, actuator_id
+    ),
+    '[]'::json
+  ) INTO v_schedules
+  FROM public.device_schedules
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  RETURN json_build_object(
+    'actuators', v_actuators,
+    'loops', v_loops,
+    'rules', v_rules,
+    'schedules', v_schedules
+  );
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.get_device_control_config(text) TO authenticated, anon;
+
+COMMENT ON FUNCTION public.get_device_control_config IS
+  'Returns actuator wiring, control loops, automation rules and schedules for a device. Called by ESP8266 v3.2.0 on config sync';
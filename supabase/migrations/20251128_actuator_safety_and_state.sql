@@ -0,0 +1,249 @@
+-- =====================================================
+-- Migration: Actuator safety limit + actuator states in heartbeat
+-- Date: 2025-11-28
+-- Firmware: ESP8266 v3.2.0 (actuators.cpp)
+-- =====================================================
+
+-- =====================================================
+-- max_on_s: longest continuous on time, enforced on the device whoever
+--           switched it on (0 = no limit). A tripped actuator stays off
+--           until it is switched off or a new manual command arrives.
+-- Reported state (heartbeat, every 60 s):
+--   output_percent, remaining_s (NULL = open ended), manual_hold,
+--   safety_tripped, state_reported_at
+-- =====================================================
+
+ALTER TABLE public.actuators
+ADD COLUMN IF NOT EXISTS max_on_s INTEGER DEFAULT 0 NOT NULL CHECK (max_on_s BETWEEN 0 AND 65535),
+ADD COLUMN IF NOT EXISTS output_percent SMALLINT,
+ADD COLUMN IF NOT EXISTS remaining_s INTEGER,
+ADD COLUMN IF NOT EXISTS manual_hold BOOLEAN DEFAULT FALSE NOT NULL,
+ADD COLUMN IF NOT EXISTS safety_tripped BOOLEAN DEFAULT FALSE NOT NULL,
+ADD COLUMN IF NOT EXISTS state_reported_at TIMESTAMPTZ;
+
+COMMENT ON COLUMN public.actuators.max_on_s IS
+  'Safety limit for continuous on time in seconds, enforced by the device (0 = none)';
+
+-- max_on_s is part of the device wiring config, reported state is not
+DROP TRIGGER IF EXISTS trigger_increment_config_version_actuators ON public.actuators;
+
+CREATE TRIGGER trigger_increment_config_version_actuators
+  AFTER INSERT OR DELETE OR UPDATE OF actuator_id, port_id, output_type, ramp_ms, max_on_s, is_active
+  ON public.actuators
+  FOR EACH ROW
+  EXECUTE FUNCTION public.increment_device_config_version();
+
+-- =====================================================
+-- Function: device_heartbeat_with_config_v3 (with actuator states)
+-- Params: actuators_param = [{actuator_id, output, remaining_s?, manual?, tripped?}]
+-- Returns: unchanged
+-- =====================================================
+
+-- Replaced by the version with actuators_param (optional, older callers work)
+DROP FUNCTION IF EXISTS public.device_heartbeat_with_config_v3(text, text, integer);
+
+CREATE OR REPLACE FUNCTION public.device_heartbeat_with_config_v3(
+  composite_device_id_param text,
+  firmware_version_param text DEFAULT NULL,
+  max_commands_param integer DEFAULT 4,
+  actuators_param json DEFAULT NULL
+)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  v_config_version INTEGER;
+  v_commands JSON;
+  v_command_ids UUID[];
+  result JSON;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id, config_version INTO v_device_id, v_config_version
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  -- Update last_seen_at (and optionally firmware_version)
+  UPDATE public.devices
+  SET last_seen_at = NOW(),
+      firmware_version = COALESCE(firmware_version_param, firmware_version)
+  WHERE id = v_device_id;
+
+  -- Actuator states reported by the device (output %, remaining run time)
+  IF actuators_param IS NOT NULL THEN
+    UPDATE public.actuators a
+    SET output_percent = (s->>'output')::SMALLINT,
+        remaining_s = (s->>'remaining_s')::INTEGER,
+        manual_hold = COALESCE((s->>'manual')::BOOLEAN, FALSE),
+        safety_tripped = COALESCE((s->>'tripped')::BOOLEAN, FALSE),
+        state_reported_at = NOW()
+    FROM json_array_elements(actuators_param) AS s
+    WHERE a.device_id = v_device_id
+      AND a.actuator_id = s->>'actuator_id';
+  END IF;
+
+  -- Oldest pending/unacknowledged commands first, bounded by device queue space
+  SELECT
+    COALESCE(json_agg(json_build_object(
+      'id', c.id,
+      'type', c.command_type,
+      'payload', c.payload
+    ) ORDER BY c.created_at), '[]'::json),
+    array_agg(c.id)
+  INTO v_commands, v_command_ids
+  FROM (
+    SELECT id, command_type, payload, created_at
+    FROM public.device_commands
+    WHERE device_id = v_device_id
+      AND status IN ('pending', 'delivered')
+      AND (expires_at IS NULL OR expires_at > NOW())
+    ORDER BY created_at ASC
+    LIMIT GREATEST(LEAST(max_commands_param, 10), 0)
+  ) c;
+
+  -- Mark as delivered
+  IF v_command_ids IS NOT NULL THEN
+    UPDATE public.device_commands
+    SET status = 'delivered',
+        delivered_at = COALESCE(delivered_at, NOW())
+    WHERE id = ANY(v_command_ids);
+  END IF;
+
+  SELECT json_build_object(
+    'success', true,
+    'device_id', v_device_id,
+    'composite_device_id', composite_device_id_param,
+    'config_version', v_config_version,
+    'commands', v_commands,
+    'timestamp', NOW()
+  ) INTO result;
+
+  RETURN result;
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.device_heartbeat_with_config_v3(text, text, integer, json) TO authenticated, anon;
+
+COMMENT ON FUNCTION public.device_heartbeat_with_config_v3 IS
+  'Heartbeat returning config_version and a bounded array of pending commands. Also stores actuator states reported by v3.2.0';
+
+-- =====================================================
+-- Function: get_device_control_config (actuators with max_on_s)
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.get_device_control_config(composite_device_id_param text)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  v_actuators JSON;
+  v_loops JSON;
+  v_rules JSON;
+  v_schedules JSON;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id INTO v_device_id
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'output_type', output_type,
+        'port_id', port_id,
+        'ramp_ms', ramp_ms,
+        'max_on_s', max_on_s
+      )
+      ORDER BY actuator_id
+    ),
+    '[]'::json
+  ) INTO v_actuators
+  FROM public.actuators
+  WHERE device_id = v_device_id
+    AND is_active = TRUE
+    AND output_type IS NOT NULL
+    AND port_id IS NOT NULL;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'sensor_type', sensor_type,
+        'mode', mode,
+        'cooling', cooling,
+        'setpoint', setpoint,
+        'hysteresis', hysteresis,
+        'kp', kp,
+        'ki', ki,
+        'kd', kd
+      )
+      ORDER BY actuator_id
+    ),
+    '[]'::json
+  ) INTO v_loops
+  FROM public.device_control_loops
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'condition', condition,
+        'value', value,
+        'duration_s', duration_s
+      )
+      ORDER BY position, updated_at
+    ),
+    '[]'::json
+  ) INTO v_rules
+  FROM public.device_rules
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  -- weekdays INT[] (0 = Sunday) -> bit mask, start_time -> seconds after midnight
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'actuator_id', actuator_id,
+        'start_s', EXTRACT(EPOCH FROM start_time)::INTEGER,
+        'weekdays', (SELECT COALESCE(SUM(1 << d), 0) FROM unnest(weekdays) AS d),
+        'duration_s', duration_s,
+        'value', value,
+        'missed_policy', missed_policy
+      )
+      ORDER BY start_time, actuator_id
+    ),
+    '[]'::json
+  ) INTO v_schedules
+  FROM public.device_schedules
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  RETURN json_build_object(
+    'actuators', v_actuators,
+    'loops', v_loops,
+    'rules', v_rules,
+    'schedules', v_schedules
+  );
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.get_device_control_config(text) TO authenticated, anon;
+
+COMMENT ON FUNCTION public.get_device_control_config IS
+  'Returns actuator wiring, control loops, automation rules and schedules for a device. Called by ESP8266 v3.2.0 on config sync';
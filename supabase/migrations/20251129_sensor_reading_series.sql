@@ -0,0 +1,258 @@
+-- =====================================================
+-- Migration: Compressed sample series in sensor uploads
+-- Date: 2025-11-29
+-- Firmware: ESP8266 v3.2.0 (series.cpp, sensors.cpp)
+-- =====================================================
+
+-- =====================================================
+-- After failed uploads the device sends the samples it kept in RAM as one
+-- entry per sensor value instead of one object per sample:
+--   encoding:  'dod-delta-v1'
+--   scale:     value = decoded integer / scale (100: centi-units)
+--   count:     number of samples
+--   data:      base64 bit stream (series.h on the device)
+--   ts / uptime_ms: time of the first sample, as for single readings
+-- Single samples are still sent as plain readings.
+--
+-- Bit stream, bits least significant first within each byte (get_bit()):
+--   per sample: time in ms after the first sample (first: 32 bit raw,
+--   then delta-of-delta), then the value as delta from the previous one
+--   (from 0 for the first). Deltas are zigzag coded behind a prefix:
+--   "0" = 0, "10" + 4 bit, "110" + 8 bit, "1110" + 12 bit, "1111" + 32 bit
+-- =====================================================
+
+-- Unsigned integer of bits bits at bit position pos
+CREATE OR REPLACE FUNCTION series_read_bits(data BYTEA, pos INT, bits INT)
+RETURNS BIGINT
+LANGUAGE plpgsql
+IMMUTABLE
+AS $$
+DECLARE
+  v_value BIGINT := 0;
+  i INT;
+BEGIN
+  FOR i IN 0 .. bits - 1 LOOP
+    v_value := v_value | (get_bit(data, pos + i)::BIGINT << i);
+  END LOOP;
+  RETURN v_value;
+END;
+$$;
+
+-- One zigzag coded delta at bit position pos (advanced past it)
+CREATE OR REPLACE FUNCTION series_read_delta(data BYTEA, INOUT pos INT, OUT delta BIGINT)
+LANGUAGE plpgsql
+IMMUTABLE
+AS $$
+DECLARE
+  v_widths INT[] := ARRAY[0, 4, 8, 12, 32];
+  v_bucket INT := 0;
+  v_zigzag BIGINT;
+BEGIN
+  WHILE v_bucket < 4 AND get_bit(data, pos) = 1 LOOP
+    v_bucket := v_bucket + 1;
+    pos := pos + 1;
+  END LOOP;
+  IF v_bucket < 4 THEN
+    pos := pos + 1;  -- Terminating 0
+  END IF;
+
+  v_zigzag := series_read_bits(data, pos, v_widths[v_bucket + 1]);
+  pos := pos + v_widths[v_bucket + 1];
+  delta := (v_zigzag >> 1) # -(v_zigzag & 1);
+END;
+$$;
+
+-- Samples of a dod-delta-v1 series (raises on truncated data)
+CREATE OR REPLACE FUNCTION decode_sample_series(data BYTEA, point_count INT)
+RETURNS TABLE(offset_ms BIGINT, value BIGINT)
+LANGUAGE plpgsql
+IMMUTABLE
+AS $$
+DECLARE
+  v_pos INT := 32;
+  v_delta BIGINT := 0;
+  v_step BIGINT;
+  i INT;
+BEGIN
+  IF point_count IS NULL OR point_count < 1 THEN
+    RETURN;
+  END IF;
+
+  offset_ms := series_read_bits(data, 0, 32);
+  value := 0;
+  FOR i IN 1 .. point_count LOOP
+    IF i > 1 THEN
+      SELECT r.pos, r.delta INTO v_pos, v_step FROM series_read_delta(data, v_pos) AS r;
+      v_delta := v_delta + v_step;
+      offset_ms := offset_ms + v_delta;
+    END IF;
+    SELECT r.pos, r.delta INTO v_pos, v_step FROM series_read_delta(data, v_pos) AS r;
+    value := value + v_step;
+    RETURN NEXT;
+  END LOOP;
+END;
+$$;
+
+CREATE OR REPLACE FUNCTION insert_sensor_readings(readings JSONB, uptime_ms BIGINT DEFAULT NULL)
+RETURNS JSONB
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  reading_item JSONB;
+  v_device_id UUID;
+  v_composite_device_id TEXT;
+  v_sensor_type TEXT;
+  v_sensor_name TEXT;
+  v_port_id TEXT;
+  v_value NUMERIC;
+  v_unit TEXT;
+  v_timestamp TIMESTAMPTZ;
+  v_age_ms BIGINT;
+  v_sensor_id UUID;
+  v_generated_sensor_id TEXT;
+  v_configured_sensor_type TEXT;
+  inserted_count INTEGER := 0;
+BEGIN
+  -- Series entries (dod-delta-v1): one reading per decoded point, stamped
+  -- at the entry's ts / uptime_ms plus the point offset
+  readings := (
+    SELECT COALESCE(jsonb_agg(expanded.item), '[]'::jsonb)
+    FROM jsonb_array_elements(readings) AS entry(item)
+    CROSS JOIN LATERAL (
+      SELECT entry.item AS item
+      WHERE entry.item->>'encoding' IS NULL
+      UNION ALL
+      SELECT (entry.item - ARRAY['encoding', 'scale', 'count', 'data', 'ts', 'uptime_ms'])
+        || jsonb_build_object('value', point.value::NUMERIC / COALESCE((entry.item->>'scale')::NUMERIC, 1))
+        || CASE
+             WHEN entry.item ? 'ts' THEN jsonb_build_object('ts',
+               (entry.item->>'ts')::TIMESTAMPTZ + point.offset_ms * INTERVAL '1 millisecond')
+             WHEN entry.item ? 'uptime_ms' THEN jsonb_build_object('uptime_ms',
+               ((entry.item->>'uptime_ms')::BIGINT + point.offset_ms) % 4294967296)
+             ELSE '{}'::jsonb
+           END
+      FROM decode_sample_series(decode(entry.item->>'data', 'base64'), (entry.item->>'count')::INT) AS point
+      WHERE entry.item->>'encoding' = 'dod-delta-v1'
+    ) AS expanded
+  );
+
+  -- Loop through each reading
+  FOR reading_item IN SELECT * FROM jsonb_array_elements(readings)
+  LOOP
+    -- Extract reading info
+    v_composite_device_id := reading_item->>'composite_device_id';
+    v_sensor_type := reading_item->>'sensor_type';
+    v_sensor_name := reading_item->>'sensor_name';
+    v_port_id := reading_item->>'port_id';  -- May be NULL
+    v_value := (reading_item->>'value')::NUMERIC;
+    v_unit := reading_item->>'unit';
+
+    -- Sample time: device epoch stamp (SNTP synced), else rebase the
+    -- boot-relative millis() stamp on the request uptime (32 bit, wraps),
+    -- else insert time (older firmware)
+    v_timestamp := NOW();
+    IF reading_item ? 'ts' THEN
+      v_timestamp := (reading_item->>'ts')::TIMESTAMPTZ;
+    ELSIF reading_item ? 'uptime_ms' AND uptime_ms IS NOT NULL THEN
+      v_age_ms := ((uptime_ms - (reading_item->>'uptime_ms')::BIGINT) % 4294967296 + 4294967296) % 4294967296;
+      v_timestamp := NOW() - v_age_ms * INTERVAL '1 millisecond';
+    END IF;
+
+    -- Device clock far ahead of the server: do not trust it
+    IF v_timestamp > NOW() + INTERVAL '5 minutes' THEN
+      v_timestamp := NOW();
+    END IF;
+
+    -- Get device UUID from composite_device_id
+    SELECT id INTO v_device_id
+    FROM devices
+    WHERE composite_device_id = v_composite_device_id;
+
+    IF v_device_id IS NULL THEN
+      RAISE EXCEPTION 'Device not found: %', v_composite_device_id;
+    END IF;
+
+    -- OPTIONAL: If port_id is provided, try to use sensor configuration
+    IF v_port_id IS NOT NULL THEN
+      -- Try to get configured sensor type from device_sensor_configs
+      SELECT sensor_type INTO v_configured_sensor_type
+      FROM device_sensor_configs
+      WHERE device_id = v_device_id
+        AND port_id = v_port_id
+        AND is_active = true;
+
+      -- If configuration exists, use it
+      IF v_configured_sensor_type IS NOT NULL THEN
+        v_sensor_type := v_configured_sensor_type;
+      END IF;
+      -- If no configuration, just use the provided sensor_type (auto-discovery)
+    END IF;
+
+    -- Check if sensor exists, if not create it (auto-discovery)
+    SELECT id INTO v_sensor_id
+    FROM sensors
+    WHERE device_id = v_device_id
+      AND name = v_sensor_name
+      AND sensor_type = v_sensor_type;
+
+    IF v_sensor_id IS NULL THEN
+      -- Generate unique sensor_id
+      v_generated_sensor_id := lower(v_sensor_type) || '_' ||
+        substring(md5(random()::text || clock_timestamp()::text) from 1 for 8);
+
+      -- Auto-register sensor
+      INSERT INTO sensors (
+        device_id,
+        sensor_id,
+        name,
+        sensor_type,
+        unit,
+        is_active,
+        discovered_at
+      ) VALUES (
+        v_device_id,
+        v_generated_sensor_id,
+        v_sensor_name,
+        v_sensor_type,
+        v_unit,
+        true,
+        NOW()
+      )
+      RETURNING id INTO v_sensor_id;
+    ELSE
+      -- Update is_active
+      UPDATE sensors
+      SET is_active = true
+      WHERE id = v_sensor_id;
+    END IF;
+
+    -- Insert reading with port_id and reading_sensor_type
+    INSERT INTO sensor_readings (
+      sensor_id,
+      timestamp,
+      value,
+      sensor_name,
+      port_id,
+      reading_sensor_type
+    ) VALUES (
+      v_sensor_id,
+      v_timestamp,
+      v_value,
+      v_sensor_name,
+      v_port_id,  -- May be NULL
+      v_sensor_type
+    );
+
+    inserted_count := inserted_count + 1;
+  END LOOP;
+
+  RETURN jsonb_build_object('success', true, 'inserted', inserted_count);
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION insert_sensor_readings(JSONB, BIGINT) TO authenticated, anon;
+
+COMMENT ON FUNCTION insert_sensor_readings(JSONB, BIGINT) IS
+  'Inserts a batch of device readings. Per reading: ts (ISO 8601) or uptime_ms (device millis() at sample, rebased on the uptime_ms parameter). Entries with encoding dod-delta-v1 carry several samples (see decode_sample_series)';
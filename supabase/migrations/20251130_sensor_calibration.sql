@@ -0,0 +1,84 @@
+-- =====================================================
+-- Migration: Per-sensor calibration in the sensor config
+-- Date: 2025-11-30
+-- Firmware: ESP8266 v3.2.0 (sample.cpp, heartbeat.cpp)
+-- =====================================================
+
+-- =====================================================
+-- calibration: correction applied on the device before upload, in the
+--              units of the value (°C, %):
+--   {"offset": 0.4, "gain": 1.02}              value * gain + offset
+--   {"points": [[raw, value], ...]}            2-8 points, raw ascending,
+--                                              linear between points
+-- NULL = readings are uploaded as measured. Stored readings are already
+-- corrected; changing the calibration does not touch older rows.
+-- =====================================================
+
+ALTER TABLE public.device_sensor_configs
+ADD COLUMN IF NOT EXISTS calibration JSONB CHECK (
+  calibration IS NULL OR (
+    jsonb_typeof(calibration) = 'object' AND (
+      NOT calibration ? 'points' OR (
+        jsonb_typeof(calibration->'points') = 'array' AND
+        jsonb_array_length(calibration->'points') BETWEEN 2 AND 8
+      )
+    ) AND (
+      NOT calibration ? 'gain' OR (calibration->>'gain')::NUMERIC BETWEEN 0.001 AND 32
+    )
+  )
+);
+
+COMMENT ON COLUMN public.device_sensor_configs.calibration IS
+  'Device-side correction: {offset, gain} or {points: [[raw, value], ...]} (2-8, raw ascending), in the value units';
+
+-- Changes reach the device through trigger_increment_config_version
+
+-- =====================================================
+-- Function: get_device_sensor_config (with calibration)
+-- Returns: JSON array of {sensor_type, port_id, configured_at, calibration}
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.get_device_sensor_config(composite_device_id_param text)
+RETURNS JSON
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_device_id UUID;
+  result JSON;
+BEGIN
+  -- Get device UUID from composite_device_id
+  SELECT id INTO v_device_id
+  FROM public.devices
+  WHERE composite_device_id = composite_device_id_param;
+
+  IF v_device_id IS NULL THEN
+    RAISE EXCEPTION 'Device not found: %', composite_device_id_param;
+  END IF;
+
+  -- Return active sensor configs as JSON array
+  SELECT COALESCE(
+    json_agg(
+      json_build_object(
+        'sensor_type', sensor_type,
+        'port_id', port_id,
+        'configured_at', configured_at,
+        'calibration', calibration
+      )
+      ORDER BY sensor_type
+    ),
+    '[]'::json
+  ) INTO result
+  FROM public.device_sensor_configs
+  WHERE device_id = v_device_id
+    AND is_active = TRUE;
+
+  RETURN result;
+END;
+$$;
+
+GRANT EXECUTE ON FUNCTION public.get_device_sensor_config(text) TO authenticated, anon;
+
+COMMENT ON FUNCTION public.get_device_sensor_config IS
+  'Returns active sensor configurations for a device as JSON array. Called by ESP8266 during heartbeat to sync config from cloud to EEPROM';
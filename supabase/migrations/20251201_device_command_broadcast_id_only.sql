@@ -0,0 +1,45 @@
+-- =====================================================
+-- Migration: Broadcast only the id of new device commands
+-- Date: 2025-12-01
+-- Firmware: ESP8266 v3.2.0 (realtime.cpp)
+-- =====================================================
+
+-- =====================================================
+-- "device:<composite_device_id>" is a public Realtime channel: anyone with
+-- the anon key who knows or guesses the composite id can subscribe. The
+-- full payload (wifi_update SSID and password, OTA URLs) must not travel
+-- on it. The broadcast now only announces the command id; the device
+-- answers with an early heartbeat, which delivers the command as before.
+-- Payload: {id}
+-- =====================================================
+
+CREATE OR REPLACE FUNCTION public.broadcast_device_command()
+RETURNS TRIGGER
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path TO 'public', 'pg_temp'
+AS $$
+DECLARE
+  v_composite_device_id TEXT;
+BEGIN
+  SELECT composite_device_id INTO v_composite_device_id
+  FROM public.devices
+  WHERE id = NEW.device_id;
+
+  IF v_composite_device_id IS NULL THEN
+    RETURN NEW;
+  END IF;
+
+  PERFORM realtime.send(
+    jsonb_build_object('id', NEW.id),
+    'command',
+    'device:' || v_composite_device_id,
+    false
+  );
+
+  RETURN NEW;
+END;
+$$;
+
+COMMENT ON FUNCTION public.broadcast_device_command IS
+  'Trigger function that announces new device_commands rows (id only) on the device Realtime channel; the device fetches the command with an early heartbeat';
@@ -0,0 +1,33 @@
+-- =====================================================
+-- Migration: Separate transfer and image hashes for firmware versions
+-- Date: 2025-12-02
+-- Firmware: ESP8266 v3.2.0 (ota.cpp), rows from firmware/tools/ota_artifacts.py
+-- =====================================================
+-- checksum_sha256 held "the" SHA-256 next to storage_path, but a release has
+-- two: the file that is downloaded (.bin or .bin.gz) and the image the device
+-- runs. The device verifies the downloaded bytes against sha256 of the
+-- firmware_update command, and LAN peers report the hash of their running
+-- image, so both are needed and must not be mixed up.
+
+ALTER TABLE public.firmware_versions
+ADD COLUMN IF NOT EXISTS image_sha256 TEXT;
+
+COMMENT ON COLUMN public.firmware_versions.checksum_sha256 IS
+  'Hex SHA-256 of the file at storage_path as downloaded (.bin or .bin.gz). Sent as sha256 in firmware_update, the device verifies the written bytes against it';
+
+COMMENT ON COLUMN public.firmware_versions.checksum_md5 IS
+  'Hex MD5 of the file at storage_path as downloaded';
+
+COMMENT ON COLUMN public.firmware_versions.image_sha256 IS
+  'Hex SHA-256 of the uncompressed firmware image (equals checksum_sha256 for a plain .bin). Sent as image_sha256 in firmware_update, matched against /firmware/info of LAN peers';
+
+-- Plain images: the file is the image
+UPDATE public.firmware_versions
+SET image_sha256 = checksum_sha256
+WHERE image_sha256 IS NULL
+  AND checksum_sha256 IS NOT NULL
+  AND storage_path NOT LIKE '%.gz';
+
+-- Compressed uploads registered before this migration cannot be told apart
+-- (the stored hash may be the image's): re-register them with the rows
+-- printed by ota_artifacts.py.